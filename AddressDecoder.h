@@ -0,0 +1,104 @@
+#ifndef CODE_ADDRESSDECODER_H
+#define CODE_ADDRESSDECODER_H
+
+#include "Include.h"
+
+/* Result of Splitting a Raw Address into its Fields for One Specific Cache
+ *
+ * Decode an address once per level and pass this around instead of the raw address,
+ * so that lookup, allocation and eviction do not repeat the decoding work.
+ */
+struct DecodedAddress {
+	address_t address{0};
+	address_t tag{0};
+	uint32_t index{0};
+	uint32_t offset{0};
+};
+
+class AddressDecoder {
+private:
+	//Number of Bits of [Tag][Index][Offset]
+	uint32_t tag_bits{0};
+	uint32_t index_bits{0};
+	uint32_t offset_bits{0};
+
+	//Shift Amounts and Masks, Precomputed so that Decoding is Two Shifts and Two Ands
+	uint32_t index_shift{0};
+	uint32_t tag_shift{0};
+	uint32_t index_mask{0};
+	uint32_t offset_mask{0};
+
+	/**
+	 * Build a mask with the lowest _bits bits set
+	 * @param _bits Number of bits in the mask (0 to 32)
+	 * @return The mask
+	 */
+	[[nodiscard]] static uint32_t lowMask(const uint32_t &_bits) {
+		return _bits >= 32 ? UINT32_MAX : static_cast<uint32_t>((uint64_t{1} << _bits) - 1);
+	}
+
+public:
+
+	AddressDecoder() = default;
+
+	/**
+	 * Precompute shifts and masks for a given field partition
+	 * @param _tag_bits Number of Tag Bits
+	 * @param _index_bits Number of Index Bits
+	 * @param _offset_bits Number of Offset Bits
+	 */
+	AddressDecoder(const uint32_t &_tag_bits, const uint32_t &_index_bits, const uint32_t &_offset_bits) {
+		if (_tag_bits + _index_bits + _offset_bits != ADDRESS_BITS)
+			throw std::invalid_argument("ERR Address Partition does not Sum to the Address Width");
+		this->tag_bits = _tag_bits;
+		this->index_bits = _index_bits;
+		this->offset_bits = _offset_bits;
+		this->index_shift = _offset_bits;
+		this->tag_shift = _offset_bits + _index_bits;
+		this->index_mask = lowMask(_index_bits);
+		this->offset_mask = lowMask(_offset_bits);
+	}
+
+	/**
+	 * Decode an Address to its [Tag][Index][Offset] Fields
+	 * @param _address Raw address
+	 * @return Decoded fields, together with the raw address
+	 */
+	[[nodiscard]] DecodedAddress decode(const address_t &_address) const {
+		DecodedAddress decoded;
+		decoded.address = _address;
+		decoded.tag = this->tag_shift >= ADDRESS_BITS ? 0 : _address >> this->tag_shift;
+		decoded.index = (_address >> this->index_shift) & this->index_mask;
+		decoded.offset = _address & this->offset_mask;
+		return decoded;
+	}
+
+	/**
+	 * Rebuild a Raw Address from its Fields
+	 * @param _tag Tag Value
+	 * @param _index Index Value
+	 * @param _offset Offset Value
+	 * @return Raw address
+	 */
+	[[nodiscard]] address_t encode(const address_t &_tag, const uint32_t &_index, const uint32_t &_offset) const {
+		address_t address_val = this->tag_shift >= ADDRESS_BITS ? 0 : _tag << this->tag_shift;
+		address_val |= address_t{_index & this->index_mask} << this->index_shift;
+		address_val |= _offset & this->offset_mask;
+		return address_val;
+	}
+
+	[[nodiscard]] uint32_t getTagBits() const {
+		return this->tag_bits;
+	}
+
+	[[nodiscard]] uint32_t getIndexBits() const {
+		return this->index_bits;
+	}
+
+	[[nodiscard]] uint32_t getOffsetBits() const {
+		return this->offset_bits;
+	}
+
+};
+
+#endif //CODE_ADDRESSDECODER_H
@@ -0,0 +1,412 @@
+#ifndef CODE_BENCH_H
+#define CODE_BENCH_H
+
+#include "Include.h"
+#include "Core.h"
+
+#include <chrono>
+#include <random>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/* Benchmark Suite of the Simulator Itself
+ *
+ * Standard hierarchies run over synthetic traces of fixed seeds, so two builds given the same arguments simulate
+ * exactly the same accesses and their rows can be compared directly. Each trace is written once as a text
+ * instruction file and once as a binary trace, both are parsed back (the parse time), then every hierarchy
+ * runs the parsed accesses quietly with logging off (the simulate time, the best of several repeats).
+ *
+ * The time of each level is the time its hierarchy gains over the same hierarchy cut just above the level, so a
+ * hierarchy of N levels is also run cut after each of its first N-1 levels. Each hierarchy runs in a forked child
+ * whose peak resident set size is reset first (Linux), so the peak covers that hierarchy alone.
+ */
+class Bench {
+	using Instruction_t = std::pair<std::string, Core::ArgumentTuple_t>;
+
+	//A Standard Hierarchy: Name and Configuration Instructions
+	struct BenchConfig {
+		std::string name;
+		std::vector<Instruction_t> instructions;
+	};
+
+	//Result of One Hierarchy over One Trace
+	struct BenchResult {
+		std::string trace;
+		std::string config;
+		double parse_text_seconds{0};
+		double parse_binary_seconds{0};
+		double simulate_seconds{0};
+		std::vector<double> level_seconds;//best simulate time of the hierarchy cut after each level
+		long peak_rss_kb{0};
+		long added_rss_kb{-1};//peak over the resident size when the hierarchy started, -1 if unknown
+		uint64_t clock_count{0};
+		std::vector<std::pair<uint64_t, uint64_t>> hit_miss_counts;
+	};
+
+	uint64_t access_count{0};
+	size_t repeat_count{1};
+	std::vector<BenchConfig> configs;
+	std::vector<BenchResult> results;
+
+	/**
+	 * Generate the Accesses of a Synthetic Trace, One per Clock Cycle, 30% of them Writes
+	 * sequential: 4-byte steps through 64 MiB; random: uniform over 64 MiB;
+	 * hotset: 90% uniform over 256 KiB, the rest uniform over 64 MiB; strided: 4 KiB steps through 16 MiB
+	 */
+	[[nodiscard]] std::vector<Task> generateTrace(const std::string &_trace_name) const {
+		std::mt19937 generator{20240101};
+		std::uniform_int_distribution<uint32_t> percent(0, 99);
+		std::uniform_int_distribution<uint32_t> wide(0, (uint32_t{64} << 20) - 1);
+		std::uniform_int_distribution<uint32_t> hot(0, (uint32_t{256} << 10) - 1);
+		std::vector<Task> tasks;
+		tasks.reserve(this->access_count);
+		for (uint64_t i = 0; i < this->access_count; i++) {
+			uint32_t address{0};
+			if (_trace_name == "sequential")
+				address = uint32_t(i * 4) & ((uint32_t{64} << 20) - 1);
+			else if (_trace_name == "random")
+				address = wide(generator);
+			else if (_trace_name == "hotset")
+				address = percent(generator) < 90 ? hot(generator) : wide(generator);
+			else if (_trace_name == "strided")
+				address = uint32_t(i * 4096) & ((uint32_t{16} << 20) - 1);
+			else
+				throw std::invalid_argument("ERR Unknown Benchmark Trace " + _trace_name);
+			task_t this_task = percent(generator) < 30 ? task_t::task_writeAddress : task_t::task_readAddress;
+			tasks.emplace_back(this_task, address, i + 1);
+		}
+		return tasks;
+	}
+
+	/**
+	 * Write a Trace as a Text Instruction File and as a Binary Trace
+	 */
+	static void writeTrace(const std::vector<Task> &_tasks, const std::string &_text_filename,
+						   const std::string &_trace_filename) {
+		std::ofstream text_writer{_text_filename, std::ios::trunc};
+		if (!text_writer.is_open())
+			throw std::runtime_error("ERR Cannot Open Benchmark Trace " + _text_filename);
+		TraceWriter trace_writer(_trace_filename);
+		for (const Task &this_task: _tasks) {
+			text_writer << (this_task.getTaskType() == task_t::task_writeAddress ? "twr" : "tre")
+						<< "\t$" << this_task.getTaskValue() << "\t$" << this_task.getArriveTime() << "\n";
+			trace_writer.append(TraceRecord{this_task.getTaskType(), this_task.getTaskValue(),
+											this_task.getArriveTime()});
+		}
+		trace_writer.close();
+	}
+
+	/**
+	 * Time how Long Loading a Trace Takes, Checking it Yields the Generated Accesses
+	 */
+	static double timeParse(const std::string &_filename, const std::vector<Task> &_expected) {
+		auto start = std::chrono::steady_clock::now();
+		std::vector<Task> tasks = loadSortedAccesses(_filename);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (tasks.size() != _expected.size() ||
+			!std::equal(tasks.begin(), tasks.end(), _expected.begin(), [](const Task &_a, const Task &_b) {
+				return _a.getTaskType() == _b.getTaskType() && _a.getTaskValue() == _b.getTaskValue() &&
+					   _a.getArriveTime() == _b.getArriveTime();
+			}))
+			throw std::runtime_error("ERR Parsed Trace Differs from Generated Trace " + _filename);
+		return seconds;
+	}
+
+	/**
+	 * Build a Quiet System of a Hierarchy, Run the Accesses and Time the Run Alone
+	 * @param _result Filled with the clock and the hits and misses of every level, unless nullptr
+	 */
+	static double simulate(const std::vector<Instruction_t> &_instructions, const std::vector<Task> &_tasks,
+						   BenchResult *_result) {
+		System system;
+		system.setQuiet(true);
+		for (const Instruction_t &this_instruction: _instructions) {
+			Core::ArgumentTuple_t arguments = this_instruction.second;
+			std::invoke(Core::getInstructionMap().at(this_instruction.first).first, system, &arguments);
+		}
+		auto start = std::chrono::steady_clock::now();
+		system.runSortedTasks(_tasks);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (_result != nullptr) {
+			_result->clock_count = system.getClockCount();
+			_result->hit_miss_counts.clear();
+			for (uint32_t level = 1; level <= system.getCacheCount(); level++)
+				_result->hit_miss_counts.push_back(system.getCacheHitMiss(level));
+		}
+		return seconds;
+	}
+
+	/**
+	 * Cut a Hierarchy after a Level, Memory Taking the Place of the Levels Below
+	 * Every instruction but con and sml names its cache level first
+	 */
+	static std::vector<Instruction_t> cutAfter(const BenchConfig &_config, const uint32_t &_level_count) {
+		std::vector<Instruction_t> instructions;
+		for (Instruction_t this_instruction: _config.instructions) {
+			if (this_instruction.first == "con")
+				std::get<0>(this_instruction.second) = _level_count;
+			else if (this_instruction.first != "sml" && std::get<0>(this_instruction.second) > _level_count)
+				continue;
+			instructions.push_back(this_instruction);
+		}
+		return instructions;
+	}
+
+	/**
+	 * Reset the Peak Resident Set Size of the Process to its Current Size
+	 * @return False where the kernel does not support it (not Linux, or before 4.0)
+	 */
+	static bool resetPeakRss() {
+		std::ofstream clear_writer{"/proc/self/clear_refs"};
+		clear_writer << "5";
+		clear_writer.flush();
+		return clear_writer.good();
+	}
+
+	/**
+	 * Read a Size Field (VmRSS, VmHWM) of /proc/self/status, in KiB, -1 if Unavailable
+	 */
+	static long statusKb(const std::string &_field) {
+		std::ifstream status_reader{"/proc/self/status"};
+		std::string this_line;
+		while (std::getline(status_reader, this_line))
+			if (this_line.compare(0, _field.size() + 1, _field + ":") == 0)
+				return std::stol(this_line.substr(_field.size() + 1));
+		return -1;
+	}
+
+	/**
+	 * Peak Resident Set Size of the Process so Far, in KiB (Used where the Peak Cannot be Reset)
+	 */
+	static long peakRssKb() {
+		struct rusage usage{};
+		::getrusage(RUSAGE_SELF, &usage);
+		return usage.ru_maxrss;
+	}
+
+	/**
+	 * Time a Hierarchy, and Each of its Cuts, over a Trace, Recording the Peak Resident Set Size Meanwhile
+	 */
+	void measure(const BenchConfig &_config, const std::vector<Task> &_tasks, BenchResult &_result) const {
+#ifdef __GLIBC__
+		::malloc_trim(0);//hand free heap pages back, so the hierarchy's allocations count as new resident pages
+#endif
+		const bool rss_reset = resetPeakRss();
+		const long start_rss_kb = rss_reset ? statusKb("VmRSS") : -1;
+		_result.simulate_seconds = std::numeric_limits<double>::max();
+		for (size_t i = 0; i < this->repeat_count; i++)
+			_result.simulate_seconds = std::min(_result.simulate_seconds, simulate(_config.instructions, _tasks, &_result));
+		_result.peak_rss_kb = rss_reset ? statusKb("VmHWM") : peakRssKb();
+		if (rss_reset && start_rss_kb >= 0 && _result.peak_rss_kb >= 0)
+			_result.added_rss_kb = _result.peak_rss_kb - start_rss_kb;
+		const uint32_t level_count = _result.hit_miss_counts.size();
+		_result.level_seconds.assign(level_count, std::numeric_limits<double>::max());
+		_result.level_seconds.back() = _result.simulate_seconds;
+		for (uint32_t level = 1; level < level_count; level++) {
+			std::vector<Instruction_t> cut_instructions = cutAfter(_config, level);
+			for (size_t i = 0; i < this->repeat_count; i++)
+				_result.level_seconds[level - 1] = std::min(_result.level_seconds[level - 1],
+															simulate(cut_instructions, _tasks, nullptr));
+		}
+	}
+
+	/**
+	 * Measure a Hierarchy in a Forked Child, so its Memory is not Mixed with Heap Pages Earlier Hierarchies Left
+	 * Resident; the child sends its measurements back through a pipe. Measures in-process where fork fails.
+	 */
+	void measureInChild(const BenchConfig &_config, const std::vector<Task> &_tasks, BenchResult &_result) const {
+		int pipe_ends[2];
+		if (::pipe(pipe_ends) != 0) {
+			this->measure(_config, _tasks, _result);
+			return;
+		}
+		std::cout.flush();
+		const pid_t child = ::fork();
+		if (child < 0) {
+			::close(pipe_ends[0]);
+			::close(pipe_ends[1]);
+			this->measure(_config, _tasks, _result);
+			return;
+		}
+		if (child == 0) {
+			::close(pipe_ends[0]);
+			std::vector<char> message;
+			auto append = [&message](const auto &_value) {
+				const char *bytes = reinterpret_cast<const char *>(&_value);
+				message.insert(message.end(), bytes, bytes + sizeof(_value));
+			};
+			try {
+				this->measure(_config, _tasks, _result);
+			} catch (const std::exception &_error) {
+				std::cerr << _error.what() << std::endl;
+				::_exit(1);
+			}
+			append(_result.simulate_seconds);
+			append(_result.peak_rss_kb);
+			append(_result.added_rss_kb);
+			append(_result.clock_count);
+			append(uint64_t{_result.hit_miss_counts.size()});
+			for (size_t level = 0; level < _result.hit_miss_counts.size(); level++) {
+				append(_result.hit_miss_counts[level]);
+				append(_result.level_seconds[level]);
+			}
+			size_t written{0};
+			while (written < message.size()) {
+				ssize_t count = ::write(pipe_ends[1], message.data() + written, message.size() - written);
+				if (count <= 0) ::_exit(1);
+				written += count;
+			}
+			::_exit(0);
+		}
+		::close(pipe_ends[1]);
+		std::vector<char> message;
+		char chunk[4096];
+		ssize_t count;
+		while ((count = ::read(pipe_ends[0], chunk, sizeof(chunk))) > 0)
+			message.insert(message.end(), chunk, chunk + count);
+		::close(pipe_ends[0]);
+		int status{0};
+		::waitpid(child, &status, 0);
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			throw std::runtime_error("ERR Benchmark of " + _config.name + " Failed");
+		size_t cursor{0};
+		auto take = [&message, &cursor](auto &_value) {
+			if (cursor + sizeof(_value) > message.size())
+				throw std::runtime_error("ERR Benchmark Result Truncated");
+			std::memcpy(static_cast<void *>(&_value), message.data() + cursor, sizeof(_value));
+			cursor += sizeof(_value);
+		};
+		uint64_t level_count{0};
+		take(_result.simulate_seconds);
+		take(_result.peak_rss_kb);
+		take(_result.added_rss_kb);
+		take(_result.clock_count);
+		take(level_count);
+		_result.hit_miss_counts.resize(level_count);
+		_result.level_seconds.resize(level_count);
+		for (size_t level = 0; level < level_count; level++) {
+			take(_result.hit_miss_counts[level]);
+			take(_result.level_seconds[level]);
+		}
+	}
+
+public:
+
+	/**
+	 * @param _access_count Accesses per synthetic trace
+	 * @param _repeat_count Runs of every hierarchy per trace, the fastest is kept
+	 */
+	Bench(const uint64_t &_access_count, const size_t &_repeat_count) {
+		if (_access_count == 0 || _repeat_count == 0)
+			throw std::invalid_argument("ERR Benchmark Needs at Least One Access and One Repeat");
+		this->access_count = _access_count;
+		this->repeat_count = _repeat_count;
+		this->configs = {
+				{"l1_32k",       {{"con", {1, 64, 1}},
+										 {"scd", {1, 32768, 8}}, {"scl", {1, 4, 0}}, {"inc", {1, 0, 0}},
+										 {"sml", {100, 0, 0}}}},
+				{"l1_l2",        {{"con", {2, 64, 1}},
+										 {"scd", {1, 32768, 8}}, {"scl", {1, 4, 0}}, {"inc", {1, 0, 0}},
+										 {"scd", {2, 262144, 8}}, {"scl", {2, 12, 0}}, {"inc", {2, 0, 0}},
+										 {"sml", {100, 0, 0}}}},
+				{"l1_l2_l3",     {{"con", {3, 64, 1}},
+										 {"scd", {1, 32768, 8}}, {"scl", {1, 4, 0}}, {"inc", {1, 0, 0}},
+										 {"scd", {2, 262144, 8}}, {"scl", {2, 12, 0}}, {"inc", {2, 0, 0}},
+										 {"scd", {3, 2097152, 16}}, {"scl", {3, 40, 0}}, {"inc", {3, 0, 0}},
+										 {"sml", {200, 0, 0}}}},
+				{"l1_l2_wtnwa",  {{"con", {2, 64, 2}},
+										 {"scd", {1, 32768, 8}}, {"scl", {1, 4, 0}}, {"inc", {1, 0, 0}},
+										 {"scd", {2, 262144, 8}}, {"scl", {2, 12, 0}}, {"inc", {2, 0, 0}},
+										 {"sml", {100, 0, 0}}}},
+				{"l1_l2_srrip",  {{"con", {2, 64, 1}},
+										 {"scd", {1, 32768, 8}}, {"scl", {1, 4, 0}}, {"inc", {1, 0, 0}},
+										 {"scd", {2, 262144, 8}}, {"scl", {2, 12, 0}}, {"srp", {2, 3, 0}},
+										 {"inc", {2, 0, 0}}, {"sml", {100, 0, 0}}}}};
+	}
+
+	/**
+	 * Run Every Hierarchy over Every Synthetic Trace
+	 * @param _work_prefix Prefix of the trace files written and parsed back, removed afterwards
+	 */
+	void run(const std::string &_work_prefix) {
+		for (const std::string trace_name: {"sequential", "random", "hotset", "strided"}) {
+			std::vector<Task> tasks = this->generateTrace(trace_name);
+			std::string text_filename = _work_prefix + trace_name + ".txt";
+			std::string trace_filename = _work_prefix + trace_name + ".ctr";
+			writeTrace(tasks, text_filename, trace_filename);
+			double parse_text_seconds = timeParse(text_filename, tasks);
+			double parse_binary_seconds = timeParse(trace_filename, tasks);
+			std::remove(text_filename.c_str());
+			std::remove(trace_filename.c_str());
+			for (const BenchConfig &this_config: this->configs) {
+				BenchResult result;
+				result.trace = trace_name;
+				result.config = this_config.name;
+				result.parse_text_seconds = parse_text_seconds;
+				result.parse_binary_seconds = parse_binary_seconds;
+				this->measureInChild(this_config, tasks, result);
+				std::cout << std::setw(12) << std::left << trace_name << std::setw(14) << std::left << this_config.name
+						  << std::setw(14) << std::left << uint64_t(double(this->access_count) / result.simulate_seconds)
+						  << "accesses/s" << std::endl;
+				this->results.push_back(std::move(result));
+			}
+		}
+	}
+
+	/**
+	 * Write One Row per (Trace, Hierarchy)
+	 * Columns: LABEL, TRACE, CONFIG, ACCESSES, PARSE_TEXT_S, PARSE_BINARY_S, SIMULATE_S, ACCESSES_PER_S,
+	 * NS_PER_ACCESS, PEAK_RSS_KB (peak while the hierarchy ran, the process' peak so far where it cannot be reset),
+	 * ADDED_RSS_KB (that peak over the resident size when the hierarchy started, empty where unknown), CLOCK,
+	 * then HITS, MISSES, MISS_RATE and NS_PER_ACCESS of each level. The ns of a level are the time the level adds
+	 * to the hierarchy cut above it (clamped at 0 against timing noise) over its lookups, hits plus misses;
+	 * those of L1 also hold the per-access cost of the simulator itself
+	 * @param _results_filename CSV file to be written
+	 * @param _label Free text naming the build, e.g. a version, repeated on every row
+	 */
+	void printResults(const std::string &_results_filename, const std::string &_label) const {
+		size_t level_count{0};
+		for (const BenchResult &this_result: this->results)
+			level_count = std::max(level_count, this_result.hit_miss_counts.size());
+		std::ofstream results_writer{_results_filename, std::ios::trunc};
+		if (!results_writer.is_open())
+			throw std::runtime_error("ERR Cannot Open Results File " + _results_filename);
+		results_writer << "LABEL,TRACE,CONFIG,ACCESSES,PARSE_TEXT_S,PARSE_BINARY_S,SIMULATE_S,ACCESSES_PER_S,"
+						  "NS_PER_ACCESS,PEAK_RSS_KB,ADDED_RSS_KB,CLOCK";
+		for (size_t level = 1; level <= level_count; level++)
+			results_writer << ",L" << level << "_HITS,L" << level << "_MISSES,L" << level << "_MISS_RATE,L" << level
+						   << "_NS_PER_ACCESS";
+		results_writer << std::endl;
+		for (const BenchResult &this_result: this->results) {
+			double simulate_ns = this_result.simulate_seconds * 1e9;
+			results_writer << _label << "," << this_result.trace << "," << this_result.config << ","
+						   << this->access_count << "," << this_result.parse_text_seconds << ","
+						   << this_result.parse_binary_seconds << "," << this_result.simulate_seconds << ","
+						   << double(this->access_count) / this_result.simulate_seconds << ","
+						   << simulate_ns / double(this->access_count) << "," << this_result.peak_rss_kb << ",";
+			if (this_result.added_rss_kb >= 0)
+				results_writer << this_result.added_rss_kb;
+			results_writer << "," << this_result.clock_count;
+			for (size_t level = 0; level < level_count; level++) {
+				if (level >= this_result.hit_miss_counts.size()) {
+					results_writer << ",,,,";
+					continue;
+				}
+				uint64_t hits = this_result.hit_miss_counts[level].first;
+				uint64_t misses = this_result.hit_miss_counts[level].second;
+				double level_ns = std::max(0.0, this_result.level_seconds[level] -
+												(level == 0 ? 0.0 : this_result.level_seconds[level - 1])) * 1e9;
+				results_writer << "," << hits << "," << misses << ","
+							   << (hits + misses == 0 ? 0.0 : double(misses) / double(hits + misses)) << ","
+							   << (hits + misses == 0 ? 0.0 : level_ns / double(hits + misses));
+			}
+			results_writer << std::endl;
+		}
+	}
+};
+
+#endif //CODE_BENCH_H
@@ -1,20 +1,48 @@
 #ifndef CODE_CACHE_H
 #define CODE_CACHE_H
 
-#include "DataBlock.h"
+#include "TagStore.h"
+#include "ReplacementPolicy.h"
+#include "AddressDecoder.h"
+#include "SetSampling.h"
+#include "Prefetcher.h"
+#include "Mshr.h"
+#include "VictimCache.h"
+
+#include <charconv>
+#include <filesystem>
+#include <numeric>
 
 class Cache {
+public:
+	/* Counters of the Access Path of this Cache, Plain Increments with no Formatting or I/O
+	 *
+	 * Write-backs are dirty blocks this cache sent to the level below (victims, interventions, exclusive swaps);
+	 * write-throughs are write misses it passed on to the level below under Write-Thru + Non-Write-Allocate.
+	 */
+	struct CacheCount {
+		uint64_t read_hits{0};
+		uint64_t read_misses{0};
+		uint64_t write_hits{0};
+		uint64_t write_misses{0};
+		uint64_t allocations{0};
+		uint64_t clean_evictions{0};
+		uint64_t dirty_evictions{0};
+		uint64_t writebacks{0};
+		uint64_t writethroughs{0};
+	};
+
 private:
 
-	//#0:Pointer of Cache one Unit closer to Memory, nullptr if is bottom cache
-	std::unique_ptr<Cache> parent_cache_ptr{nullptr};
+	//#0:Pointer of Cache one Unit closer to Memory, nullptr if is bottom cache (Owned by the System)
+	Cache *parent_cache_ptr{nullptr};
 
-	/* #1 Information of the Partition of Address for this Specific Cache
+	/* #1 Decoder of the Partition of Address for this Specific Cache
 	 *
-	 * [Number of Tag Bits][Number Of Index Bits][Number Of Offset Bits]
+	 * [Number of Tag Bits][Number Of Index Bits][Number Of Offset Bits], with Shifts and Masks Precomputed
 	 *
 	 */
-	std::tuple<size_t, size_t, size_t> address_partition{0, 0, 0};
+	AddressDecoder decoder;
 
 	/* #2 Information of the Dimensions for this Specific Cache
 	 *
@@ -22,16 +50,23 @@ private:
 	 */
 	std::tuple<uint32_t, uint32_t, uint32_t> dimensions{0, 0, 0};
 
-	/* #3 2D Vector cache array containing DataBlock
+	/* #3 Flat Tag Store containing Tags, Valid and Dirty Bits of Every DataBlock
 	 *
-	 * To access individual element from cache array, do the following:
-	 * this->cache_array.at(A).at(B).getValid() access Cache[A][B].Valid - bool type is returned
-	 * this->cache_array.at(A).at(B).getDirty() access Cache[A][B].Dirty - bool type is returned
-	 * this->cache_array.at(A).at(B).getTag() access Cache[A][B].Tag - uint32_t type is returned
+	 * To access individual element from tag store, do the following:
+	 * this->tag_store.getValid(A, B) access Cache[A][B].Valid - bool type is returned
+	 * this->tag_store.getDirty(A, B) access Cache[A][B].Dirty - bool type is returned
+	 * this->tag_store.getTag(A, B) access Cache[A][B].Tag - address_t type is returned
 	 *
 	 * A: Index of Blocks, B: Index of Associated Set
 	 */
-	std::vector<std::vector<DataBlock>> cache_array;
+	TagStore tag_store;
+
+	/* Replacement Policy and its Per-Set State, Kept Apart from the Tag Store
+	 *
+	 * Chosen by srp before inc, LRU if never chosen. Created by initCacheArray.
+	 */
+	replacement_t replacement_type{replacement_t::repl_lru};
+	std::unique_ptr<ReplacementPolicy> replacement_policy{nullptr};
 
 	/* Total Counts of Hits and Misses of this Cache (No need to initialize)
 	 *
@@ -39,51 +74,152 @@ private:
 	 */
 	std::pair<uint64_t, uint64_t> hit_miss_count{0, 0};
 
+	/* Misses and Accesses of Each Sampling Class, Only Kept when the System Samples Sets (sss)
+	 *
+	 * class_counts[index & class_mask]: [Number of Misses][Number of Accesses]
+	 */
+	std::vector<std::pair<uint64_t, uint64_t>> class_counts;
+	std::vector<uint8_t> sampled_classes;
+	uint32_t class_mask{0};
+
 	//#4: Number of Clock Cycles to Complete Read for this Cache
 	uint64_t latency{0};//#5
 
 	//#5 Layer ID of this Specific Cache with the lowest being 1
 	size_t cache_id{0};//#6
 
+	//Core Owning this Private Cache, -1 if Shared (or the System has a Single Core)
+	int64_t core_id{-1};
+
+	//Prefetcher of this Cache, Chosen by spf (Off by Default)
+	Prefetcher prefetcher;
+
+	//Miss Status Holding Registers of this Cache, Set by mhr (None while Caches Block)
+	MshrFile mshr_file;
+
+	//Victim Cache of this Cache, Attached by svc (None by Default)
+	VictimCache victim_cache;
+
+	//Blocks of the Levels above this Cache its Evictions Invalidated, Only Reported in Inclusive Hierarchies
+	uint64_t back_invalidations{0};
+	bool report_back_invalidations{false};
+
+	//Counters of the Access Path, Reported by pcs
+	CacheCount counts;
+
+	/* Sets Changed since the Last Delta Image, Only Tracked when the System Dumps Delta Images (sim)
+	 *
+	 * changed_sets[index] is 1 once the set is listed in changed_list; both are cleared by each delta image
+	 */
+	std::vector<uint8_t> changed_sets;
+	std::vector<uint32_t> changed_list;
+
 	//Status of Initialization. All Members MUST be true before Cache Initialization
 	std::array<bool, 6> ready{false, false, false, false, false, false};
 
+	/**
+	 * Part of Report File Names Naming the Core of a Private Cache, Empty if Shared
+	 */
+	[[nodiscard]] std::string coreSuffix() const {
+		return this->core_id < 0 ? "" : "_c" + std::to_string(this->core_id);
+	}
 
-	[[nodiscard]] uint32_t addressEncode(const std::tuple<uint32_t, uint32_t, uint32_t> &_add_part) {
-		uint32_t address_val = std::get<0>(_add_part);
-		address_val = (address_val << std::get<1>(this->address_partition)) + std::get<1>(_add_part);
-		address_val = (address_val << std::get<2>(this->address_partition)) + std::get<2>(_add_part);
-		return address_val;
+	/**
+	 * Record that a Set's Image Changed, if Delta Images are Tracked
+	 */
+	void markChanged(const uint32_t &_index) {
+		if (this->changed_sets.empty() || this->changed_sets[_index]) return;
+		this->changed_sets[_index] = 1;
+		this->changed_list.push_back(_index);
+	}
+
+	static void appendNumber(std::string &_line, const uint64_t &_value) {
+		char digits[24];
+		auto result = std::to_chars(digits, digits + sizeof(digits), _value);
+		_line.append(digits, result.ptr);
+	}
+
+	/**
+	 * Title Row of an Image
+	 */
+	[[nodiscard]] std::string imageTitles() const {
+		std::string titles{"B_IND"};
+		for (size_t col = 0; col < std::get<1>(this->dimensions); col++)
+			titles += ",VALID[" + std::to_string(col) + "]" +
+					  ",DIRTY[" + std::to_string(col) + "]" +
+					  ",TAG[" + std::to_string(col) + "]" +
+					  "," + this->replacement_policy->getName() + "[" + std::to_string(col) + "]";
+		titles += '\n';
+		return titles;
+	}
+
+	/**
+	 * Append the Row of One Set to an Image
+	 */
+	void appendImageRow(std::string &_line, const uint32_t &_row) const {
+		_line += "B[";
+		appendNumber(_line, _row);
+		_line += ']';
+		for (uint32_t col = 0; col < std::get<1>(this->dimensions); col++) {
+			_line += ',';
+			appendNumber(_line, this->tag_store.getValid(_row, col));
+			_line += ',';
+			appendNumber(_line, this->tag_store.getDirty(_row, col));
+			_line += ',';
+			appendNumber(_line, this->tag_store.getTag(_row, col));
+			_line += ',';
+			appendNumber(_line, this->replacement_policy->getState(_row, col));
+		}
+		_line += '\n';
 	}
 
 
 public:
 	/**
-* Decode a 32-bit Address to 3-fields Index-based Tuple indicating where the Data could be
-* Warning: This function should ONLY be used inside this Cache Class
-* @param address_val Raw 32-bit address
-* @return [Tag Value][Index of Index][Index of Offset]
-*/
-	[[nodiscard]] std::tuple<uint32_t, uint32_t, uint32_t> addressDecode(const uint32_t &address_val) const {
-		std::tuple<uint32_t, uint32_t, uint32_t> indices;
-		std::string address_bit = std::bitset<32>(address_val).to_string();
-		uint32_t bits[3];
-		bits[0] = std::get<0>(this->address_partition);
-		bits[1] = std::get<1>(this->address_partition);
-		bits[2] = std::get<2>(this->address_partition);
-		std::get<0>(indices) = std::bitset<32>(address_bit.substr(0, bits[0])).to_ulong();
-		std::get<1>(indices) = std::bitset<32>(address_bit.substr(bits[0], bits[1])).to_ulong();
-		std::get<2>(indices) = std::bitset<32>(address_bit.substr(bits[1], bits[2])).to_ulong();
-
-/*		std::get<0>(indices) =
-				address_val >> (std::get<2>(this->address_partition) + std::get<1>(this->address_partition));
-		std::get<1>(indices) =
-				address_val << std::get<0>(this->address_partition)
-							>> (std::get<2>(this->address_partition) + std::get<0>(this->address_partition));
-		std::get<2>(indices) =
-				address_val << (std::get<0>(this->address_partition) + std::get<1>(this->address_partition))
-							>> (std::get<0>(this->address_partition) + std::get<1>(this->address_partition));*/
-		return indices;
+	 * Decode an Address to 3-fields Index-based Struct indicating where the Data could be
+	 * Decode once per level, then pass the result to lookup, allocation and eviction
+	 * @param _address Raw address
+	 * @return [Tag Value][Index of Index][Index of Offset]
+	 */
+	[[nodiscard]] DecodedAddress addressDecode(const address_t &_address) const {
+		return this->decoder.decode(_address);
+	}
+
+	/**
+	 * Get the Address Decoder of this Cache
+	 * @return Decoder holding this cache's field partition
+	 */
+	[[nodiscard]] const AddressDecoder &getDecoder() const {
+		return this->decoder;
+	}
+
+	/**
+	 * Get the Total Counts of Hits and Misses
+	 * @return [Number of Hits][Number of Misses]
+	 */
+	[[nodiscard]] const std::pair<uint64_t, uint64_t> &getHitMissCount() const {
+		return this->hit_miss_count;
+	}
+
+	/**
+	 * Get the Counters of the Access Path
+	 */
+	[[nodiscard]] const CacheCount &getCounts() const {
+		return this->counts;
+	}
+
+	/**
+	 * Count a Dirty Block Sent to the Level Below
+	 */
+	void countWriteBack() {
+		this->counts.writebacks++;
+	}
+
+	/**
+	 * Count a Write Miss Passed on to the Level Below (Write-Thru)
+	 */
+	void countWriteThrough() {
+		this->counts.writethroughs++;
 	}
 
 	/**
@@ -98,49 +234,113 @@ public:
 
 	/**
 	 * Find if there's a tag matching the address.
-	 * @param _address Raw 32-bit address
+	 * @param _decoded Address decoded by this Cache
 	 * @param _dirty If dirty bit should been set
+	 * @param _write If the access is a write, to count read and write hits and misses apart
 	 * @return True if found and update, false otherwise
 	 */
-	bool updateExistingTag(const uint32_t &_address, const uint64_t &_clock_now, const bool &_dirty) {
-		std::tuple<uint32_t, uint32_t, uint32_t> this_index_tuple = addressDecode(_address);
-		for (DataBlock &this_dataBlock: cache_array.at(std::get<1>(this_index_tuple))) {
-			if (this_dataBlock.compareTag(std::get<0>(this_index_tuple))) {
-				this_dataBlock.markDirty(_clock_now, _dirty);
-				hit_miss_count.first++;
-				return true;
-			}
+	bool updateExistingTag(const DecodedAddress &_decoded, const bool &_dirty, const bool &_write) {
+		int64_t way = tag_store.findTag(_decoded.index, _decoded.tag);
+		if (!class_counts.empty()) {
+			auto &this_class = class_counts[_decoded.index & class_mask];
+			this_class.first += way < 0;
+			this_class.second++;
+		}
+		if (way < 0) {
+			hit_miss_count.second++;
+			(_write ? counts.write_misses : counts.read_misses)++;
+			return false;
 		}
-		hit_miss_count.second++;
-		return false;
+		tag_store.setDirty(_decoded.index, way, _dirty);
+		replacement_policy->touch(_decoded.index, way);
+		markChanged(_decoded.index);
+		hit_miss_count.first++;
+		(_write ? counts.write_hits : counts.read_hits)++;
+		return true;
 	}
 
-	[[nodiscard]] std::pair<bool, uint32_t> popFlushLRUTag(const uint32_t &_address) {
-		std::tuple<uint32_t, uint32_t, uint32_t> this_index_tuple = addressDecode(_address);
-		DataBlock *least_used_db = &(cache_array.at(std::get<1>(this_index_tuple)).at(0));
-		for (DataBlock &this_dataBlock: cache_array.at(std::get<1>(this_index_tuple))) {
-			if (this_dataBlock < (*least_used_db))
-				least_used_db = &this_dataBlock;
-		}
-		std::tuple<uint32_t, uint32_t, uint32_t> parted_address
-				{least_used_db->getTag(), std::get<1>(this_index_tuple), std::get<2>(this_index_tuple)};
-		std::pair<bool, uint32_t> dirty_and_address{least_used_db->getDirty(), addressEncode(parted_address)};
-		if (least_used_db->getDirty()) {
-			int i = 0;
+	/**
+	 * Find if there's a tag matching the address and update it like updateExistingTag, without Counting a Hit or Miss
+	 * For the functional fast-forward, whose counts are cleared anyway
+	 * @param _decoded Address decoded by this Cache
+	 * @param _dirty If dirty bit should been set
+	 * @return True if found and update, false otherwise
+	 */
+	bool touchTag(const DecodedAddress &_decoded, const bool &_dirty) {
+		int64_t way = tag_store.findTag(_decoded.index, _decoded.tag);
+		if (way < 0)
+			return false;
+		tag_store.setDirty(_decoded.index, way, _dirty);
+		replacement_policy->touch(_decoded.index, way);
+		markChanged(_decoded.index);
+		return true;
+	}
+
+	/**
+	 * Check if the Cache Holds an Address, without Counting or Touching Anything
+	 * @param _decoded Address decoded by this Cache
+	 */
+	[[nodiscard]] bool containsTag(const DecodedAddress &_decoded) const {
+		return tag_store.findTag(_decoded.index, _decoded.tag) >= 0;
+	}
+
+	/**
+	 * Check if the Cache Holds an Address in a Dirty DataBlock, without Counting or Touching Anything
+	 * @param _decoded Address decoded by this Cache
+	 */
+	[[nodiscard]] bool isDirtyTag(const DecodedAddress &_decoded) const {
+		int64_t way = tag_store.findTag(_decoded.index, _decoded.tag);
+		return way >= 0 && tag_store.getDirty(_decoded.index, way);
+	}
+
+	/**
+	 * Merge a Block Moved in from another Level into the Copy this Cache Already Holds, without Counting a Hit or Miss
+	 * @param _decoded Address decoded by this Cache
+	 * @param _dirty If the moved block is dirty (a clean one leaves the dirty bit as it is)
+	 * @return True if the cache held the block, false otherwise (nothing changed)
+	 */
+	bool mergeTag(const DecodedAddress &_decoded, const bool &_dirty) {
+		int64_t way = tag_store.findTag(_decoded.index, _decoded.tag);
+		if (way < 0)
+			return false;
+		if (_dirty) {
+			tag_store.setDirty(_decoded.index, way, true);
+			markChanged(_decoded.index);
 		}
-		least_used_db->flush();
+		return true;
+	}
+
+	/**
+	 * Evict the DataBlock the Replacement Policy Chooses from the Set the Address Maps to
+	 * Warning: Only call when the set is full
+	 * @param _decoded Address decoded by this Cache
+	 * @return [If Evicted DataBlock was Dirty][Raw Address of Evicted DataBlock]
+	 */
+	[[nodiscard]] std::pair<bool, address_t> popFlushVictimTag(const DecodedAddress &_decoded) {
+		uint32_t victim_way = replacement_policy->victim(_decoded.index);
+		std::pair<bool, address_t> dirty_and_address
+				{tag_store.getDirty(_decoded.index, victim_way),
+				 decoder.encode(tag_store.getTag(_decoded.index, victim_way), _decoded.index, _decoded.offset)};
+		tag_store.invalidate(_decoded.index, victim_way);
+		markChanged(_decoded.index);
+		(dirty_and_address.first ? this->counts.dirty_evictions : this->counts.clean_evictions)++;
 		return dirty_and_address;
 	}
 
-	bool allocateNewTag(const uint32_t &_address, const bool &_dirty, const uint64_t &_clock_time) {
-		std::tuple<uint32_t, uint32_t, uint32_t> this_index_tuple = addressDecode(_address);
-		for (DataBlock &this_dataBlock: cache_array.at(std::get<1>(this_index_tuple))) {
-			if (!this_dataBlock.getValid()) {
-				this_dataBlock.update(std::get<0>(this_index_tuple), _dirty, _clock_time);
-				return true;
-			}
-		}
-		return false;
+	/**
+	 * Place the Address' Tag into the First Invalid DataBlock of its Set
+	 * @param _decoded Address decoded by this Cache
+	 * @return True if allocated, false if the set is full
+	 */
+	bool allocateNewTag(const DecodedAddress &_decoded, const bool &_dirty) {
+		int64_t way = tag_store.findInvalid(_decoded.index);
+		if (way < 0)
+			return false;
+		tag_store.fill(_decoded.index, way, _decoded.tag, _dirty);
+		replacement_policy->insert(_decoded.index, way);
+		markChanged(_decoded.index);
+		counts.allocations++;
+		return true;
 	}
 
 	/**
@@ -148,21 +348,17 @@ public:
 	 * @return Pointer of Parent Cache
 	 */
 	[[nodiscard]] Cache *getParentPtr() const {
-		return this->parent_cache_ptr.get();
-	}
-
-	void makeAsTopCache() {
-		this->parent_cache_ptr = nullptr;
-		this->ready.at(0) = true;
+		return this->parent_cache_ptr;
 	}
 
 	/**
- * Create Parent Cache
- * Mark Parent Cache has been set in Ready
- */
-	void makeParent() {
-		this->parent_cache_ptr = std::make_unique<Cache>();
-		this->parent_cache_ptr->ready.at(0) = true;
+	 * Point this Cache to its Parent Cache
+	 * Mark Parent Cache has been set in Ready
+	 * @param _parent Cache one level closer to memory, nullptr for memory
+	 */
+	void linkParent(Cache *_parent) {
+		this->parent_cache_ptr = _parent;
+		this->ready.at(0) = true;
 	}
 
 	/**
@@ -179,13 +375,25 @@ public:
 		std::get<1>(this->dimensions) = _set_assoc;//Number of data-blocks does one index maps to
 		std::get<2>(this->dimensions) = num_of_cache_block;//Number of cache-blocks does cache-array have
 		this->ready.at(2) = true;
-		std::get<2>(this->address_partition) = lround(log2l(_block_size));//Bits of Offset
-		std::get<1>(this->address_partition) = lround(log2l(num_of_cache_block));//Bits of Index
-		std::get<0>(this->address_partition) =
-				32 - std::get<2>(this->address_partition) - std::get<1>(this->address_partition);//Bits of Tag
+		uint32_t offset_bits = lround(log2l(_block_size));//Bits of Offset
+		uint32_t index_bits = lround(log2l(num_of_cache_block));//Bits of Index
+		if (num_of_cache_block == 0 || (uint64_t{1} << index_bits) != num_of_cache_block)
+			throw std::invalid_argument("ERR Number of Cache Blocks is not a Power of Two");
+		if (offset_bits + index_bits > ADDRESS_BITS)
+			throw std::invalid_argument("ERR Cache Larger than the Address Space");
+		this->decoder = AddressDecoder{ADDRESS_BITS - offset_bits - index_bits, index_bits, offset_bits};//Tag Takes the Rest
 		this->ready.at(1) = true;
 	}
 
+	/**
+	 * Choose the Replacement Policy of this Specific Cache
+	 * Warning: Takes effect when the Cache Array is initialized
+	 * @param _policy Replacement Policy Number (see replacement_t)
+	 */
+	void setReplacementPolicy(const replacement_t &_policy) {
+		this->replacement_type = _policy;
+	}
+
 	/**
 	 * Set the Latency of this Specific Cache
 	 * Mark Latency has been set in Ready
@@ -222,6 +430,182 @@ public:
 		return this->cache_id;
 	}
 
+	/**
+	 * Mark this Cache as Private to a Core; its Report Files are Named after the Core
+	 */
+	void setCore(const int64_t &_core_id) {
+		this->core_id = _core_id;
+	}
+
+	/**
+	 * Look Up a Block for Coherence without Counting a Hit or Miss or Touching the Replacement State
+	 * A found block is made clean (its data is written back by the caller if it was dirty)
+	 * @param _decoded Address decoded by this Cache
+	 * @param _invalidate If the found block should also be invalidated
+	 * @return [If the Block was Present][If it was Dirty]
+	 */
+	std::pair<bool, bool> snoopTag(const DecodedAddress &_decoded, const bool &_invalidate) {
+		int64_t way = tag_store.findTag(_decoded.index, _decoded.tag);
+		if (way < 0)
+			return {false, false};
+		bool was_dirty = tag_store.getDirty(_decoded.index, way);
+		if (_invalidate)
+			tag_store.invalidate(_decoded.index, way);
+		else
+			tag_store.setDirty(_decoded.index, way, false);
+		markChanged(_decoded.index);
+		return {true, was_dirty};
+	}
+
+	/**
+	 * Get the Number of Sets of this Cache
+	 */
+	[[nodiscard]] uint32_t getSetCount() const {
+		return std::get<2>(this->dimensions);
+	}
+
+	/**
+	 * Count Misses per Sampling Class, so Hit/Miss Reports carry Confidence Intervals
+	 * @param _sampler Sampler of the System, already initialized
+	 */
+	void enableSampling(const SetSampler &_sampler) {
+		this->sampled_classes = _sampler.getSampledClasses();
+		this->class_mask = this->sampled_classes.size() - 1;
+		this->class_counts.assign(this->sampled_classes.size(), {0, 0});
+	}
+
+	/**
+	 * Track the Sets Changed between Images, so pci Writes Only those (Delta Images)
+	 * Every set counts as changed until the first image, which is therefore complete
+	 * Warning: Only call once the Cache Array is initialized
+	 */
+	void enableDeltaImages() {
+		this->changed_sets.assign(this->getSetCount(), 1);
+		this->changed_list.resize(this->getSetCount());
+		std::iota(this->changed_list.begin(), this->changed_list.end(), 0);
+	}
+
+	/**
+	 * Get the Prefetcher of this Cache
+	 */
+	[[nodiscard]] Prefetcher &getPrefetcher() {
+		return this->prefetcher;
+	}
+
+	/**
+	 * Get the Miss Status Holding Registers of this Cache
+	 */
+	[[nodiscard]] MshrFile &getMshrFile() {
+		return this->mshr_file;
+	}
+
+	/**
+	 * Get the Victim Cache of this Cache
+	 */
+	[[nodiscard]] VictimCache &getVictimCache() {
+		return this->victim_cache;
+	}
+
+	/**
+	 * Count a Block of a Level above Invalidated by an Eviction from this Cache
+	 */
+	void countBackInvalidation() {
+		this->back_invalidations++;
+	}
+
+	/**
+	 * Add BACK_INVALIDATIONS to the Hit/Miss Reports of this Cache
+	 */
+	void reportBackInvalidations() {
+		this->report_back_invalidations = true;
+	}
+
+	/**
+	 * Clear Every Counter of this Cache and of its Prefetcher, MSHRs and Victim Cache, Keeping its Contents
+	 */
+	void resetCounts() {
+		this->hit_miss_count = {0, 0};
+		this->back_invalidations = 0;
+		this->counts = {};
+		std::fill(this->class_counts.begin(), this->class_counts.end(), std::pair<uint64_t, uint64_t>{0, 0});
+		this->prefetcher.resetCounts();
+		this->mshr_file.resetCounts();
+		this->victim_cache.resetCounts();
+	}
+
+	/**
+	 * Replace the Hit, Miss and Sampling Counts with the Sum of the Same Cache in Every Shard of a Parallel Run
+	 * @param _shard_caches This cache's counterpart in each shard
+	 */
+	void mergeCounts(const std::vector<const Cache *> &_shard_caches) {
+		this->hit_miss_count = {0, 0};
+		this->back_invalidations = 0;
+		this->counts = {};
+		std::fill(this->class_counts.begin(), this->class_counts.end(), std::pair<uint64_t, uint64_t>{0, 0});
+		for (const Cache *shard_cache: _shard_caches) {
+			this->hit_miss_count.first += shard_cache->hit_miss_count.first;
+			this->hit_miss_count.second += shard_cache->hit_miss_count.second;
+			this->back_invalidations += shard_cache->back_invalidations;
+			this->counts.read_hits += shard_cache->counts.read_hits;
+			this->counts.read_misses += shard_cache->counts.read_misses;
+			this->counts.write_hits += shard_cache->counts.write_hits;
+			this->counts.write_misses += shard_cache->counts.write_misses;
+			this->counts.allocations += shard_cache->counts.allocations;
+			this->counts.clean_evictions += shard_cache->counts.clean_evictions;
+			this->counts.dirty_evictions += shard_cache->counts.dirty_evictions;
+			this->counts.writebacks += shard_cache->counts.writebacks;
+			this->counts.writethroughs += shard_cache->counts.writethroughs;
+			for (size_t i = 0; i < this->class_counts.size(); i++) {
+				this->class_counts[i].first += shard_cache->class_counts[i].first;
+				this->class_counts[i].second += shard_cache->class_counts[i].second;
+			}
+		}
+	}
+
+	/**
+	 * Write the Whole State of this Cache to a Checkpoint
+	 * Geometry and replacement policy come first, so a restore into a different cache fails before reading the rest
+	 */
+	void saveState(CheckpointWriter &_writer) const {
+		_writer.write(std::get<0>(this->dimensions));
+		_writer.write(std::get<1>(this->dimensions));
+		_writer.write(std::get<2>(this->dimensions));
+		_writer.write(uint32_t(this->replacement_type));
+		_writer.write(this->hit_miss_count.first);
+		_writer.write(this->hit_miss_count.second);
+		_writer.write(this->back_invalidations);
+		_writer.write(this->counts);
+		_writer.writeVector(this->class_counts);
+		this->tag_store.saveState(_writer);
+		this->replacement_policy->saveState(_writer);
+		this->prefetcher.saveState(_writer);
+		this->mshr_file.saveState(_writer);
+		this->victim_cache.saveState(_writer);
+	}
+
+	/**
+	 * Restore the State Written by saveState into a Cache Configured the Same Way
+	 * Warning: Only call once the Cache Array is initialized
+	 */
+	void loadState(CheckpointReader &_reader) {
+		_reader.expect(std::get<0>(this->dimensions));
+		_reader.expect(std::get<1>(this->dimensions));
+		_reader.expect(std::get<2>(this->dimensions));
+		_reader.expect(uint32_t(this->replacement_type));
+		this->hit_miss_count.first = _reader.read<uint64_t>();
+		this->hit_miss_count.second = _reader.read<uint64_t>();
+		this->back_invalidations = _reader.read<uint64_t>();
+		this->counts = _reader.read<CacheCount>();
+		_reader.readArray(this->class_counts.data(), this->class_counts.size());
+		this->tag_store.loadState(_reader);
+		this->replacement_policy->loadState(_reader);
+		for (uint32_t row = 0; row < this->changed_sets.size(); row++)
+			markChanged(row);
+		this->prefetcher.loadState(_reader);
+		this->mshr_file.loadState(_reader);
+		this->victim_cache.loadState(_reader);
+	}
+
 	/**
 	 * Perform Ready Check to See if Requisites are Met for Cache Array Initialization
 	 * Initialize Cache Array to Correct Dimensions with Invalid Non-Dirty Zero-Tagged DataBlock
@@ -229,56 +613,202 @@ public:
 	void initCacheArray() {
 		if (!this->ready.at(2))
 			throw std::invalid_argument("ERR inc called before scd");
-		DataBlock empty_data_block{std::get<0>(this->dimensions)};
-		std::vector<DataBlock> empty_cache_block{std::get<1>(this->dimensions), empty_data_block};
-		this->cache_array.resize(std::get<2>(this->dimensions), empty_cache_block);
+		this->tag_store.init(std::get<2>(this->dimensions), std::get<1>(this->dimensions));
+		this->replacement_policy = makeReplacementPolicy(this->replacement_type);
+		this->replacement_policy->init(std::get<2>(this->dimensions), std::get<1>(this->dimensions));
 		this->ready.at(3) = true;
 	}
 
 
 	/**
 	 * Report Hit and Misses Count to File.
+	 * When sampling sets, counts cover the sampled sets only, followed by the fraction of sets sampled
+	 * and the 95% confidence interval of the miss rate; the columns of an enabled prefetcher, MSHR file, victim
+	 * cache and back-invalidations follow either way
 	 * @param _global_writer_ptr
 	 */
 	void printHitMissRate(const uint64_t &_arrive_time) {
 		std::string hitmiss_name =
-				"hmr_l" + std::to_string(this->cache_id) + "_" + std::to_string(_arrive_time) + ".csv";
+				"hmr_l" + std::to_string(this->cache_id) + this->coreSuffix() + "_" + std::to_string(_arrive_time) +
+				".csv";
 		std::ofstream hitmiss_writer{hitmiss_name};
-		hitmiss_writer << "HITS,MISSES,HIT_R,MISS_R" << std::endl;
-		hitmiss_writer << this->hit_miss_count.first << "," << this->hit_miss_count.second << ","
-					   << std::to_string(
-							   float(hit_miss_count.first) / float(hit_miss_count.second + hit_miss_count.first)) << ","
-					   << std::to_string(
-							   float(hit_miss_count.second) / float(hit_miss_count.second + hit_miss_count.first))
-					   << std::endl;
+		const bool sampled = !this->class_counts.empty();
+		hitmiss_writer << "HITS,MISSES,HIT_R,MISS_R";
+		if (sampled)
+			hitmiss_writer << ",SAMPLED_FRACTION,MISS_R_LOW,MISS_R_HIGH";
+		if (this->prefetcher.isEnabled())
+			hitmiss_writer << ",PF_ISSUED,PF_USEFUL,PF_LATE,PF_USELESS,PF_POLLUTION,PF_ACCURACY,PF_COVERAGE,PF_TIMELINESS";
+		if (this->mshr_file.isEnabled())
+			hitmiss_writer << ",MSHR_MISSES,MSHR_MERGES,MSHR_FULL_STALLS,MSHR_STALL_CYCLES";
+		if (this->victim_cache.isEnabled())
+			hitmiss_writer << ",VC_HITS,VC_INSERTIONS,VC_WRITEBACKS";
+		if (this->report_back_invalidations)
+			hitmiss_writer << ",BACK_INVALIDATIONS";
+		hitmiss_writer << std::endl;
+		hitmiss_writer << this->hit_miss_count.first << "," << this->hit_miss_count.second << ",";
+		if (sampled) {
+			SampleEstimate miss_estimate{this->class_counts, this->sampled_classes};
+			hitmiss_writer << std::to_string(1 - miss_estimate.ratio) << ","
+						   << std::to_string(miss_estimate.ratio) << ","
+						   << std::to_string(miss_estimate.fraction) << ","
+						   << std::to_string(miss_estimate.low) << ","
+						   << std::to_string(miss_estimate.high);
+		} else
+			hitmiss_writer << std::to_string(
+					float(hit_miss_count.first) / float(hit_miss_count.second + hit_miss_count.first)) << ","
+						   << std::to_string(
+								   float(hit_miss_count.second) / float(hit_miss_count.second + hit_miss_count.first));
+		if (this->prefetcher.isEnabled()) {//accuracy: useful / issued, coverage: useful / (useful + misses left),
+			const Prefetcher::PrefetchCount &counts = this->prefetcher.getCounts();//timeliness: on-time / useful
+			hitmiss_writer << "," << counts.issued << "," << counts.useful << "," << counts.late << ","
+						   << counts.useless << "," << counts.pollution << ","
+						   << std::to_string(counts.issued == 0 ? 0.0 : double(counts.useful) / double(counts.issued)) << ","
+						   << std::to_string(counts.useful + counts.demand_misses == 0 ? 0.0 :
+											 double(counts.useful) / double(counts.useful + counts.demand_misses)) << ","
+						   << std::to_string(counts.useful == 0 ? 0.0 :
+											 double(counts.useful - counts.late) / double(counts.useful));
+		}
+		if (this->mshr_file.isEnabled()) {
+			const MshrFile::MshrCount &counts = this->mshr_file.getCounts();
+			hitmiss_writer << "," << counts.misses << "," << counts.merges << "," << counts.full_stalls << ","
+						   << counts.stall_cycles;
+		}
+		if (this->victim_cache.isEnabled()) {
+			const VictimCache::VictimCount &counts = this->victim_cache.getCounts();
+			hitmiss_writer << "," << counts.hits << "," << counts.insertions << "," << counts.writebacks;
+		}
+		if (this->report_back_invalidations)
+			hitmiss_writer << "," << this->back_invalidations;
+		hitmiss_writer << std::endl;
 		hitmiss_writer.close();
 	}
 
+	/**
+	 * Column Names of the Counters, as Written by appendCounts
+	 */
+	static const char *countTitles() {
+		return "READ_HITS,READ_MISSES,WRITE_HITS,WRITE_MISSES,ALLOCATIONS,CLEAN_EVICTIONS,DIRTY_EVICTIONS,"
+			   "WRITEBACKS,WRITETHROUGHS";
+	}
+
+	/**
+	 * Append the Counters to a CSV Row, in the Order of countTitles
+	 */
+	void appendCounts(std::string &_line) const {
+		const uint64_t values[]{counts.read_hits, counts.read_misses, counts.write_hits, counts.write_misses,
+								counts.allocations, counts.clean_evictions, counts.dirty_evictions, counts.writebacks,
+								counts.writethroughs};
+		for (size_t i = 0; i < std::size(values); i++) {
+			if (i != 0) _line += ',';
+			appendNumber(_line, values[i]);
+		}
+	}
+
+	/**
+	 * Report the Counters of the Access Path to File
+	 */
+	void printCounts(const uint64_t &_arrive_time) const {
+		std::ofstream count_writer{
+				"cnt_l" + std::to_string(this->cache_id) + this->coreSuffix() + "_" + std::to_string(_arrive_time) +
+				".csv"};
+		std::string line{countTitles()};
+		line += '\n';
+		this->appendCounts(line);
+		line += '\n';
+		count_writer.write(line.data(), static_cast<std::streamsize>(line.size()));
+	}
+
 	void printCacheImage(const uint64_t &_arrive_time) {
 		std::string image_name =
-				"img_l" + std::to_string(this->cache_id) + "_" + std::to_string(_arrive_time) + ".csv";
+				"img_l" + std::to_string(this->cache_id) + this->coreSuffix() + "_" + std::to_string(_arrive_time) +
+				".csv";
 		std::ofstream image_writer{image_name};
-		//Print Titles
-		image_writer << "B_IND";
-		for (size_t col = 0; col < std::get<1>(this->dimensions); col++)
-			image_writer << ",VALID[" + std::to_string(col) + "]" +
-							",DIRTY[" + std::to_string(col) + "]" +
-							",TAG[" + std::to_string(col) + "]" +
-							",LRU[" + std::to_string(col) + "]";
-		image_writer << std::endl;
-		//Print Contents
-		for (size_t row = 0; row < std::get<2>(this->dimensions); row++) {
-			image_writer << "B[" + std::to_string(row) + "]";
-			for (size_t col = 0; col < std::get<1>(this->dimensions); col++) {
-				const DataBlock &this_db = this->cache_array.at(row).at(col);
-				image_writer << "," + std::to_string(this_db.getValid()) +
-								"," + std::to_string(this_db.getDirty()) +
-								"," + std::to_string(this_db.getTag()) +
-								"," + std::to_string(this_db.getLastUse());
+		std::string line = this->imageTitles();
+		for (uint32_t row = 0; row < std::get<2>(this->dimensions); row++) {
+			this->appendImageRow(line, row);
+			if (line.size() >= (1 << 16)) {
+				image_writer.write(line.data(), static_cast<std::streamsize>(line.size()));
+				line.clear();
+			}
+		}
+		image_writer.write(line.data(), static_cast<std::streamsize>(line.size()));
+		image_writer.close();
+	}
+
+	/**
+	 * Write the Rows of the Sets Changed since the Previous Delta Image, in the Format of a Full Image
+	 * The first delta image of a cache holds every set; rebuildImage applies a chain of them to get a full image
+	 * @param _arrive_time Clock Cycle at when the Image is Taken
+	 */
+	void printCacheDelta(const uint64_t &_arrive_time) {
+		std::string image_name =
+				"dlt_l" + std::to_string(this->cache_id) + this->coreSuffix() + "_" + std::to_string(_arrive_time) +
+				".csv";
+		std::ofstream image_writer{image_name};
+		std::sort(this->changed_list.begin(), this->changed_list.end());
+		std::string line = this->imageTitles();
+		for (const uint32_t &row: this->changed_list) {
+			this->appendImageRow(line, row);
+			this->changed_sets[row] = 0;
+			if (line.size() >= (1 << 16)) {
+				image_writer.write(line.data(), static_cast<std::streamsize>(line.size()));
+				line.clear();
+			}
+		}
+		image_writer.write(line.data(), static_cast<std::streamsize>(line.size()));
+		image_writer.close();
+		this->changed_list.clear();
+	}
+
+	/**
+	 * Rebuild the Full Image at a Dump Point from the Delta Images in the Current Directory
+	 * @param _prefix Delta images to be applied, without the arrive time (e.g. dlt_l2 or dlt_l1_c0)
+	 * @param _arrive_time Dump point; every delta image of _prefix taken at or before it is applied in time order
+	 * @param _image_filename Full image to be written, the same as pci would have written without delta images
+	 * @return Number of delta images applied
+	 */
+	static uint64_t rebuildImage(const std::string &_prefix, const uint64_t &_arrive_time,
+								 const std::string &_image_filename) {
+		std::vector<std::pair<uint64_t, std::string>> deltas;
+		for (const auto &this_entry: std::filesystem::directory_iterator{"."}) {
+			std::string name = this_entry.path().filename().string();
+			if (name.size() <= _prefix.size() + 5 || name.compare(0, _prefix.size() + 1, _prefix + "_") != 0 ||
+				name.compare(name.size() - 4, 4, ".csv") != 0)
+				continue;
+			std::string time = name.substr(_prefix.size() + 1, name.size() - _prefix.size() - 5);
+			if (time.find_first_not_of("0123456789") != std::string::npos)
+				continue;//another cache's images, e.g. dlt_l1_c0_... for the prefix dlt_l1
+			if (std::stoull(time) <= _arrive_time)
+				deltas.emplace_back(std::stoull(time), name);
+		}
+		if (deltas.empty())
+			throw std::runtime_error("ERR No Delta Image " + _prefix + " at or before the Arrive Time");
+		std::sort(deltas.begin(), deltas.end());
+		std::string titles;
+		std::vector<std::string> rows;
+		for (const auto &this_delta: deltas) {
+			std::ifstream delta_reader{this_delta.second};
+			std::string line;
+			if (!std::getline(delta_reader, line) || (!titles.empty() && line != titles))
+				throw std::runtime_error("ERR Delta Image " + this_delta.second + " is of another Cache");
+			titles = line;
+			while (std::getline(delta_reader, line)) {
+				if (line.compare(0, 2, "B[") != 0)
+					throw std::runtime_error("ERR Delta Image " + this_delta.second + " Malformed");
+				size_t row = std::stoul(line.substr(2));
+				if (row >= rows.size())
+					rows.resize(row + 1);
+				rows[row] = line;
 			}
-			image_writer << std::endl;
 		}
+		if (std::find(rows.begin(), rows.end(), std::string{}) != rows.end())
+			throw std::runtime_error("ERR Delta Images do not Cover Every Set");
+		std::ofstream image_writer{_image_filename};
+		image_writer << titles << '\n';
+		for (const std::string &this_row: rows)
+			image_writer << this_row << '\n';
 		image_writer.close();
+		return deltas.size();
 	}
 
 
@@ -0,0 +1,159 @@
+#ifndef CODE_CHECKPOINT_H
+#define CODE_CHECKPOINT_H
+
+#include "Include.h"
+#include "MappedFile.h"
+
+#include <cstring>
+
+/* Checkpoint Format (.ckp), Little-Endian
+ *
+ * [Header, 16 Bytes]
+ *   magic        char[8]   "CSCKPT\0\0"
+ *   version      uint32    1
+ *   address_bits uint32    32, or 64 in 64-bit builds (CACHESIM_ADDRESS_64)
+ *
+ * [Body]
+ *   Written by System::saveCheckpoint: the clock, the shape of the hierarchy and the coherence counters, then one
+ *   section per cache (Cache::saveState) holding its geometry, counters, tag store, replacement state, prefetcher,
+ *   MSHRs and victim cache.
+ *
+ * Values are raw bytes and every array is preceded by its uint64 element count, so restoring into a hierarchy
+ * shaped differently fails at the first mismatch instead of misreading the rest.
+ */
+struct CheckpointHeader {
+	char magic[8]{'C', 'S', 'C', 'K', 'P', 'T', '\0', '\0'};
+	uint32_t version{1};
+	uint32_t address_bits{ADDRESS_BITS};
+};
+
+static_assert(sizeof(CheckpointHeader) == 16, "Checkpoint Header Must be 16 Bytes");
+
+/* Buffered Writer of a Checkpoint
+ *
+ * Values are copied as raw bytes, so only types without pointers may be written.
+ */
+class CheckpointWriter {
+private:
+	static constexpr size_t BUFFER_BYTES = 1 << 20;
+
+	std::ofstream checkpoint_writer;
+	std::vector<char> write_buffer;
+
+public:
+
+	explicit CheckpointWriter(const std::string &_filename) : write_buffer(BUFFER_BYTES) {
+		this->checkpoint_writer.rdbuf()->pubsetbuf(this->write_buffer.data(), BUFFER_BYTES);
+		this->checkpoint_writer.open(_filename, std::ios::binary | std::ios::trunc);
+		if (!this->checkpoint_writer.is_open())
+			throw std::runtime_error("ERR Cannot Open Checkpoint File " + _filename);
+		this->write(CheckpointHeader{});
+	}
+
+	template<typename T>
+	void write(const T &_value) {
+		this->checkpoint_writer.write(reinterpret_cast<const char *>(&_value), sizeof(T));
+	}
+
+	/**
+	 * Write an Array Preceded by its Element Count
+	 */
+	template<typename T>
+	void writeArray(const T *_values, const size_t &_count) {
+		this->write(uint64_t{_count});
+		this->checkpoint_writer.write(reinterpret_cast<const char *>(_values),
+									  static_cast<std::streamsize>(_count * sizeof(T)));
+	}
+
+	template<typename T>
+	void writeVector(const std::vector<T> &_values) {
+		this->writeArray(_values.data(), _values.size());
+	}
+
+	void close() {
+		if (!this->checkpoint_writer.is_open()) return;
+		this->checkpoint_writer.close();
+		if (this->checkpoint_writer.fail())
+			throw std::runtime_error("ERR Cannot Write Checkpoint");
+	}
+};
+
+/* Reader of a Memory-Mapped Checkpoint
+ *
+ * Reads the mapping front to back, copying each value or array straight into the state it restores.
+ */
+class CheckpointReader {
+private:
+	MappedFile mapped_file;
+	size_t position{0};
+
+	const char *take(const size_t &_bytes) {
+		if (_bytes > this->mapped_file.getLength() - this->position)
+			throw std::runtime_error("ERR Checkpoint Truncated");
+		const char *bytes = this->mapped_file.getData() + this->position;
+		this->position += _bytes;
+		return bytes;
+	}
+
+	uint64_t takeCount() {
+		return this->read<uint64_t>();
+	}
+
+public:
+
+	explicit CheckpointReader(const std::string &_filename) : mapped_file(_filename) {
+		CheckpointHeader expected_header;
+		if (this->mapped_file.getLength() < sizeof(CheckpointHeader) ||
+			std::memcmp(this->mapped_file.getData(), &expected_header, sizeof(CheckpointHeader)) != 0)
+			throw std::runtime_error("ERR Not a Checkpoint of this Address Width");
+		this->position = sizeof(CheckpointHeader);
+	}
+
+	template<typename T>
+	T read() {
+		T value;
+		std::memcpy(&value, this->take(sizeof(T)), sizeof(T));
+		return value;
+	}
+
+	/**
+	 * Read a Value that Must Equal the Current Configuration
+	 */
+	template<typename T>
+	void expect(const T &_value) {
+		if (this->read<T>() != _value)
+			throw std::runtime_error("ERR Checkpoint does not Match the Hierarchy");
+	}
+
+	/**
+	 * Read an Array into Storage of a Fixed Size, which the Stored Element Count Must Equal
+	 */
+	template<typename T>
+	void readArray(T *_values, const size_t &_count) {
+		if (this->takeCount() != _count)
+			throw std::runtime_error("ERR Checkpoint does not Match the Hierarchy");
+		std::memcpy(static_cast<void *>(_values), this->take(_count * sizeof(T)), _count * sizeof(T));
+	}
+
+	/**
+	 * Read an Array of Any Length, Resizing the Vector to Hold it
+	 */
+	template<typename T>
+	void readVector(std::vector<T> &_values) {
+		uint64_t count = this->takeCount();
+		if (count > (this->mapped_file.getLength() - this->position) / sizeof(T))
+			throw std::runtime_error("ERR Checkpoint Truncated");
+		_values.resize(count);
+		std::memcpy(static_cast<void *>(_values.data()), this->take(count * sizeof(T)), count * sizeof(T));
+	}
+
+	/**
+	 * Check the Whole Checkpoint was Read
+	 */
+	void finish() const {
+		if (this->position != this->mapped_file.getLength())
+			throw std::runtime_error("ERR Checkpoint does not Match the Hierarchy");
+	}
+};
+
+#endif //CODE_CHECKPOINT_H
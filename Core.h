@@ -9,24 +9,78 @@
 #include "System.h"
 
 class Core {
-	using ArgumentTuple_t = std::tuple<uint32_t, uint32_t, uint32_t>;
+public:
+	using ArgumentTuple_t = std::tuple<address_t, address_t, address_t>;
 	using SystemFunction_t = std::pair<bool (System::*)(ArgumentTuple_t *), size_t>;
 
+	/**
+	 * Map of Every Instruction to its System Function and Number of Arguments
+	 * Shared by Core and Sweep
+	 */
+	static const std::unordered_map<std::string, SystemFunction_t> &getInstructionMap() {
+		static const std::unordered_map<std::string, SystemFunction_t> instruction_map{
+				{"con", {&System::setConfig, 3}},
+				{"scd", {&System::setCacheDimension, 3}},
+				{"scl", {&System::setCacheLatency, 2}},
+				{"srp", {&System::setReplacementPolicy, 2}},
+				{"sml", {&System::setMemoryLatency, 1}},
+				{"inc", {&System::initCache, 1}},
+				{"lgv", {&System::setLogLevel, 2}},
+				{"stm", {&System::setStreaming, 1}},
+				{"sss", {&System::setSampling, 2}},
+				{"spf", {&System::setPrefetcher, 3}},
+				{"mhr", {&System::setMshrs, 2}},
+				{"sip", {&System::setInclusion, 1}},
+				{"svc", {&System::setVictimCache, 2}},
+				{"cor", {&System::setCores, 3}},
+				{"par", {&System::setParallel, 1}},
+				{"lck", {&System::loadCheckpoint, 1}},
+				{"ffw", {&System::setFastForward, 2}},
+				{"sis", {&System::setIntervalStats, 3}},
+				{"sim", {&System::setImageMode, 1}},
+				{"sce", {&System::setCountExport, 1}},
+				{"tre", {&System::taskReadAddress, 2}},
+				{"twr", {&System::taskWriteAddress, 2}},
+				{"tcr", {&System::taskCoreReadAddress, 3}},
+				{"tcw", {&System::taskCoreWriteAddress, 3}},
+				{"gcf", {&System::setGenerator, 3}},
+				{"gsq", {&System::taskGenerateSequential, 3}},
+				{"gru", {&System::taskGenerateRandom, 3}},
+				{"gzf", {&System::taskGenerateZipf, 3}},
+				{"gpc", {&System::taskGenerateProducerConsumer, 3}},
+				{"gpt", {&System::taskGeneratePointerChase, 3}},
+				{"ins", {&System::initSystem, 0}},
+				{"pcr", {&System::taskPrintCacheRate, 2}},
+				{"pcs", {&System::taskPrintCounts, 2}},
+				{"plh", {&System::taskPrintLatency, 2}},
+				{"pci", {&System::taskPrintCacheImage, 2}},
+				{"pcc", {&System::taskPrintCoherence, 2}},
+				{"sck", {&System::taskSaveCheckpoint, 2}}};
+/*		instruction_map["hat"] = {&System::haltProgram, 1};*/
+		return instruction_map;
+	}
+
+private:
+
 	System system;
 	std::ifstream instruction_reader;
+	std::unique_ptr<TraceReader> trace_reader{nullptr};
 	std::unordered_map<std::string, SystemFunction_t> instruction_map;
 
 	/**
-	 * Convert an String Argument to Integer 32-bit type
-	 * @param _char_to_check Character to be checked
-	 * @return True if is a Numeric Digit, false otherwise
+	 * Convert an String Argument to an Integer as Wide as an Address
+	 * @param _argument Argument to be converted, "$" followed by decimal digits
+	 * @return Value of the argument
 	 */
-	uint32_t argumentToInt(const std::string &_argument) {
+	address_t argumentToInt(const std::string &_argument) {
 		bool dollarSignDetected = _argument.at(0) == '$';
 		bool allOtherIsDigit = std::all_of(_argument.begin() + 1, _argument.end(), ::isdigit);
 		if (!dollarSignDetected || !allOtherIsDigit)
 			throw std::runtime_error("ERR Instruction Argument Format Error");
-		return std::stoi(std::string(_argument.begin() + 1, _argument.end()), nullptr, 10);
+		unsigned long long value = std::stoull(std::string(_argument.begin() + 1, _argument.end()), nullptr, 10);
+		if (value > ADDRESS_MAX)
+			throw std::out_of_range("ERR Instruction Argument Wider than an Address");
+		return address_t(value);
 	}
 
 	/**w
@@ -69,6 +123,8 @@ class Core {
 							<< std::endl;
 					return;
 				}
+				if (this_instruction.first == "ins" && trace_reader != nullptr)//binary trace tasks join before ins
+					system.taskTrace(*trace_reader);
 				this_system_function = instruction_map.at(this_instruction.first);
 				std::invoke(this_system_function.first, system, &this_instruction.second);
 			} catch (std::exception &_exep) {
@@ -83,17 +139,7 @@ class Core {
 	 */
 	void initCore() {
 		if (!instruction_reader.is_open()) throw std::runtime_error("ERR Input File NOT Found.");
-		instruction_map["con"] = {&System::setConfig, 3};
-		instruction_map["scd"] = {&System::setCacheDimension, 3};
-		instruction_map["scl"] = {&System::setCacheLatency, 2};
-		instruction_map["sml"] = {&System::setMemoryLatency, 1};
-		instruction_map["inc"] = {&System::initCache, 1};
-		instruction_map["tre"] = {&System::taskReadAddress, 2};
-		instruction_map["twr"] = {&System::taskWriteAddress, 2};
-		instruction_map["ins"] = {&System::initSystem, 0};
-		instruction_map["pcr"] = {&System::taskPrintCacheRate, 2};
-		instruction_map["pci"] = {&System::taskPrintCacheImage, 2};
-/*		instruction_map["hat"] = {&System::haltProgram, 1};*/
+		instruction_map = getInstructionMap();
 		this->loadInstructions();
 	}
 
@@ -116,6 +162,18 @@ public:
 		this->initCore();
 	}
 
+	/**
+	 * Bind the File Reader to a Given Instruction File and Map a Binary Trace
+	 * The instruction file configures the system; the trace's tasks are scheduled right before ins
+	 * @param _instruction_filename Filename of Input Files (containing instructions)
+	 * @param _trace_filename Filename of Binary Trace (see TraceFile.h)
+	 */
+	Core(const std::string &_instruction_filename, const std::string &_trace_filename) {
+		this->instruction_reader.open(_instruction_filename);
+		this->trace_reader = std::make_unique<TraceReader>(_trace_filename);
+		this->initCore();
+	}
+
 	/**
 	 * Destructor waits for I/O finishes before thread terminates
 	 */
@@ -0,0 +1,401 @@
+#ifndef CODE_EVENTLOG_H
+#define CODE_EVENTLOG_H
+
+#include "Include.h"
+#include "AddressDecoder.h"
+
+#include <charconv>
+#include <cstring>
+
+/* Highest Log Level Compiled In
+ *
+ * Levels above it are removed at compile time, so a build with 0 has no logging code in the access path.
+ */
+#ifndef CACHESIM_LOG_MAX_LEVEL
+#define CACHESIM_LOG_MAX_LEVEL 3
+#endif
+
+/* Log Levels accepted by lgv
+ *
+ * 0: Off, 1: Summary (hit/miss per level at the end), 2: Per-Access (one line per access), 3: Full Trace
+ */
+enum class log_level_t {
+	log_off = 0, log_summary = 1, log_access = 2, log_full = 3
+};
+
+enum class oper_t : uint8_t {
+	oper_read, oper_write
+};
+
+/* Outcome of One Step of an Access at One Level, Printed after ↓[ or } in the Full Trace */
+enum class status_t : uint8_t {
+	status_none,
+	mem_read_success,
+	cache_read_hit,
+	cache_read_miss,
+	cache_read_miss_pop_dirty,
+	cache_read_miss_pop_clean,
+	cache_read_miss_alloc,
+	mem_write_success,
+	cache_write_hit_wb,
+	cache_write_miss_pop_dirty_wb,
+	cache_write_miss_pop_clean_wb,
+	cache_write_miss_alloc_wb,
+	cache_write_hit_wt,
+	cache_write_miss_propagate_wt
+};
+
+inline const char *statusName(const status_t &_status) {
+	static const char *const status_names[] = {
+			"",
+			"M_R_SUCCESS",
+			"C_R_HIT",
+			"C_R_MISS$GENERAL",
+			"C_R_MISS$ALLOC_FAILED$POP_DIRTY",
+			"C_R_MISS$ALLOC_FAILED$POP_CLEAN",
+			"C_R_MISS$ALLOC_SUCCESS",
+			"M_W_SUCCESS",
+			"C_R_HIT$MARKED_DIRTY$WB",
+			"C_W_MISS$ALLOC_FAILED$POP_DIRTY$WB",
+			"C_W_MISS$ALLOC_FAILED$POP_CLEAN$WB",
+			"C_W_MISS$ALLOC_SUCCESS$WB",
+			"C_W_HIT$WT",
+			"C_W_MISS$PROPAGATE$WT"};
+	return status_names[static_cast<size_t>(_status)];
+}
+
+/* Binary Event Log Format (.lgb), Little-Endian
+ *
+ * [Header]
+ *   magic        char[8]   "CSEVLOG\0"
+ *   version      uint32    1 for 32-bit builds, 2 for 64-bit builds (CACHESIM_ADDRESS_64)
+ *   level_count  uint32    Number of cache levels
+ *   partitions   uint32[2] per level: [Number of Index Bits][Number of Offset Bits], L1 first
+ *
+ * [Events, 16 Bytes Each, 24 in 64-bit Builds]
+ *   time         uint64    Clock time (hit/miss count for summary events)
+ *   address      uint32    Raw address, for call and access events (uint64 in 64-bit builds)
+ *   kind         uint8     event_t
+ *   cache_id     uint8     Cache level, 0 for memory
+ *   oper         uint8     oper_t
+ *   status       uint8     status_t
+ *   reserved     uint32    0 (64-bit builds only, where it pads the event to 24 bytes)
+ *
+ * Addresses are stored raw; the pretty-printer decodes them with the partitions in the header.
+ */
+enum class event_t : uint8_t {
+	event_call, event_step, event_return, event_separator, event_access_begin, event_access_end,
+	event_summary_hits, event_summary_misses
+};
+
+struct LogEvent {
+	uint64_t time{0};
+	address_t address{0};
+	event_t kind{event_t::event_call};
+	uint8_t cache_id{0};
+	oper_t oper{oper_t::oper_read};
+	status_t status{status_t::status_none};
+#ifdef CACHESIM_ADDRESS_64
+	uint32_t reserved{0};//named so the padding is written as zeros, keeping logs of the same run identical
+#endif
+};
+
+static_assert(sizeof(LogEvent) == 8 + 2 * sizeof(address_t), "Log Event Must be 16 Bytes (24 in 64-bit Builds)");
+
+class EventLog {
+private:
+	static constexpr size_t BUFFER_BYTES = 1 << 20;
+	static constexpr uint32_t LOG_VERSION = ADDRESS_BITS == 64 ? 2 : 1;
+
+	log_level_t level{log_level_t::log_full};
+	bool level_chosen{false};//false while the level is the default one
+	bool binary{false};
+	std::ofstream log_writer;
+	std::vector<char> write_buffer;
+
+	//Nesting Depth of the Full Trace, Printed as Tabs
+	uint32_t depth{0};
+
+	//One Decoder per Cache Level, for Re-Decoding Addresses of the Binary Log
+	std::vector<AddressDecoder> decoders;
+
+	//Text of the Line being Built, Reused to Avoid an Allocation per Line
+	std::string line;
+
+	[[nodiscard]] bool enabled(const log_level_t &_level) const {
+		return int(_level) <= CACHESIM_LOG_MAX_LEVEL && int(_level) <= int(this->level) && log_writer.is_open();
+	}
+
+	void appendNumber(const uint64_t &_value) {
+		char digits[24];
+		auto result = std::to_chars(digits, digits + sizeof(digits), _value);
+		line.append(digits, result.ptr);
+	}
+
+	void appendBinary(const address_t &_value) {
+		if (_value == 0) {
+			line += '0';
+			return;
+		}
+		for (int bit = 63 - __builtin_clzll(_value); bit >= 0; bit--)
+			line += ((_value >> bit) & 1) ? '1' : '0';
+	}
+
+	void appendTabs() {
+		line.append(this->depth, '\t');
+	}
+
+	void appendCache(const uint8_t &_cache_id) {
+		if (_cache_id == 0)
+			line += "MEM";
+		else {
+			line += 'L';
+			appendNumber(_cache_id);
+		}
+	}
+
+	void writeLine() {
+		line += '\n';
+		log_writer.write(line.data(), static_cast<std::streamsize>(line.size()));
+		line.clear();
+	}
+
+	void writeEvent(const LogEvent &_event) {
+		log_writer.write(reinterpret_cast<const char *>(&_event), sizeof(_event));
+	}
+
+public:
+
+	/**
+	 * Apply One Event to the Text Log
+	 * Shared by live text logging and by the pretty-printer of binary logs, so both produce the same text
+	 * @param _event Event to be written
+	 * @param _decoded Address decoded by the event's cache (call events only)
+	 */
+	void writeText(const LogEvent &_event, const DecodedAddress &_decoded) {
+		switch (_event.kind) {
+			case event_t::event_call:
+				appendTabs();
+				appendNumber(_event.time);
+				line += "→";
+				appendCache(_event.cache_id);
+				line += _event.oper == oper_t::oper_read ? "::READ({" : "::WRITE({";
+				appendNumber(_decoded.tag);
+				line += '(';
+				appendBinary(_decoded.tag);
+				line += "):";
+				appendNumber(_decoded.index);
+				line += '(';
+				appendBinary(_decoded.index);
+				line += "):";
+				appendNumber(_decoded.offset);
+				line += '(';
+				appendBinary(_decoded.offset);
+				line += ")}=";
+				appendNumber(_decoded.address);
+				line += "){";
+				writeLine();
+				this->depth++;
+				break;
+			case event_t::event_step:
+			case event_t::event_return:
+				if (this->depth == 0)
+					throw std::runtime_error("ERR Tab Count Less than 0");
+				if (_event.kind == event_t::event_return)
+					this->depth--;
+				appendTabs();
+				line += _event.kind == event_t::event_return ? "}" : "↓[";
+				appendNumber(_event.time);
+				line += "←";
+				line += statusName(_event.status);
+				if (_event.kind == event_t::event_step)
+					line += ']';
+				writeLine();
+				break;
+			case event_t::event_separator:
+				writeLine();
+				break;
+			case event_t::event_access_begin:
+				appendNumber(_event.time);
+				line += _event.oper == oper_t::oper_read ? "→READ(" : "→WRITE(";
+				appendNumber(_event.address);
+				line += ")";
+				break;
+			case event_t::event_access_end:
+				line += "→";
+				appendNumber(_event.time);
+				writeLine();
+				break;
+			case event_t::event_summary_hits:
+				appendCache(_event.cache_id);
+				line += "::HITS=";
+				appendNumber(_event.time);
+				break;
+			case event_t::event_summary_misses:
+				line += ",MISSES=";
+				appendNumber(_event.time);
+				writeLine();
+				break;
+		}
+	}
+
+	/**
+	 * Choose Log Level and Format
+	 * Warning: Takes effect when the log is opened
+	 * @param _level Log level
+	 * @param _binary True to write the compact binary log (log_system.lgb) instead of text (log_system.lgs)
+	 */
+	void setLevel(const log_level_t &_level, const bool &_binary) {
+		if (log_writer.is_open())
+			throw std::invalid_argument("ERR Log Level Set after Log Opened");
+		this->level = _level;
+		this->level_chosen = true;
+		this->binary = _binary;
+	}
+
+	/**
+	 * Check if a Level Above a Given One was Chosen, Rather than Left as the Default
+	 */
+	[[nodiscard]] bool isChosenAbove(const log_level_t &_level) const {
+		return this->level_chosen && int(this->level) > int(_level);
+	}
+
+	/**
+	 * Open the Log File, unless Logging is Off
+	 * @param _decoders Address decoder of every cache level, L1 first
+	 */
+	void open(const std::vector<AddressDecoder> &_decoders) {
+		if (log_writer.is_open() || int(this->level) == 0 || CACHESIM_LOG_MAX_LEVEL == 0) return;
+		this->decoders = _decoders;
+		this->write_buffer.resize(BUFFER_BYTES);
+		this->log_writer.rdbuf()->pubsetbuf(this->write_buffer.data(), BUFFER_BYTES);
+		if (this->binary) {
+			this->log_writer.open("log_system.lgb", std::ios::binary | std::ios::trunc);
+			const char magic[8]{'C', 'S', 'E', 'V', 'L', 'O', 'G', '\0'};
+			uint32_t version{LOG_VERSION}, level_count = _decoders.size();
+			log_writer.write(magic, sizeof(magic));
+			log_writer.write(reinterpret_cast<const char *>(&version), sizeof(version));
+			log_writer.write(reinterpret_cast<const char *>(&level_count), sizeof(level_count));
+			for (const AddressDecoder &this_decoder: _decoders) {
+				uint32_t bits[2]{this_decoder.getIndexBits(), this_decoder.getOffsetBits()};
+				log_writer.write(reinterpret_cast<const char *>(bits), sizeof(bits));
+			}
+		} else
+			this->log_writer.open("log_system.lgs");
+	}
+
+	void close() {
+		if (log_writer.is_open())
+			log_writer.close();
+	}
+
+	/**
+	 * Entering a Level (Full Trace)
+	 */
+	void call(const uint64_t &_time, const uint8_t &_cache_id, const oper_t &_oper, const DecodedAddress &_decoded) {
+		if (!enabled(log_level_t::log_full)) return;
+		LogEvent this_event{_time, _decoded.address, event_t::event_call, _cache_id, _oper, status_t::status_none};
+		if (binary) writeEvent(this_event);
+		else writeText(this_event, _decoded);
+	}
+
+	/**
+	 * Intermediate Outcome inside a Level (Full Trace)
+	 */
+	void step(const uint64_t &_time, const status_t &_status) {
+		if (!enabled(log_level_t::log_full)) return;
+		LogEvent this_event{_time, 0, event_t::event_step, 0, oper_t::oper_read, _status};
+		if (binary) writeEvent(this_event);
+		else writeText(this_event, DecodedAddress{});
+	}
+
+	/**
+	 * Leaving a Level (Full Trace)
+	 */
+	void ret(const uint64_t &_time, const status_t &_status) {
+		if (!enabled(log_level_t::log_full)) return;
+		LogEvent this_event{_time, 0, event_t::event_return, 0, oper_t::oper_read, _status};
+		if (binary) writeEvent(this_event);
+		else writeText(this_event, DecodedAddress{});
+	}
+
+	/**
+	 * One Access Completed: a Line for Per-Access Logs, a Blank Separator for the Full Trace
+	 */
+	void access(const oper_t &_oper, const address_t &_address, const uint64_t &_start, const uint64_t &_finish) {
+		if (enabled(log_level_t::log_full)) {
+			LogEvent this_event{_finish, 0, event_t::event_separator, 0, _oper, status_t::status_none};
+			if (binary) writeEvent(this_event);
+			else writeText(this_event, DecodedAddress{});
+		} else if (enabled(log_level_t::log_access)) {
+			LogEvent begin_event{_start, _address, event_t::event_access_begin, 0, _oper, status_t::status_none};
+			LogEvent end_event{_finish, _address, event_t::event_access_end, 0, _oper, status_t::status_none};
+			if (binary) {
+				writeEvent(begin_event);
+				writeEvent(end_event);
+			} else {
+				writeText(begin_event, DecodedAddress{});
+				writeText(end_event, DecodedAddress{});
+			}
+		}
+	}
+
+	/**
+	 * Hit and Miss Totals of One Level, Written when the Run Ends
+	 */
+	void summary(const uint8_t &_cache_id, const uint64_t &_hits, const uint64_t &_misses) {
+		if (!enabled(log_level_t::log_summary)) return;
+		LogEvent hits_event{_hits, 0, event_t::event_summary_hits, _cache_id, oper_t::oper_read, status_t::status_none};
+		LogEvent misses_event{_misses, 0, event_t::event_summary_misses, _cache_id, oper_t::oper_read,
+							  status_t::status_none};
+		if (binary) {
+			writeEvent(hits_event);
+			writeEvent(misses_event);
+		} else {
+			writeText(hits_event, DecodedAddress{});
+			writeText(misses_event, DecodedAddress{});
+		}
+	}
+
+	/**
+	 * Pretty-Print a Binary Event Log as the Text Log the Same Run would have Written
+	 * @param _binary_filename Binary log (.lgb)
+	 * @param _text_filename Text log to be written (.lgs)
+	 * @return Number of events printed
+	 */
+	static uint64_t printBinaryLog(const std::string &_binary_filename, const std::string &_text_filename) {
+		std::ifstream binary_reader{_binary_filename, std::ios::binary};
+		if (!binary_reader.is_open())
+			throw std::runtime_error("ERR Cannot Open Binary Log " + _binary_filename);
+		char magic[8];
+		uint32_t version{0}, level_count{0};
+		binary_reader.read(magic, sizeof(magic));
+		binary_reader.read(reinterpret_cast<char *>(&version), sizeof(version));
+		binary_reader.read(reinterpret_cast<char *>(&level_count), sizeof(level_count));
+		if (!binary_reader || std::memcmp(magic, "CSEVLOG", 8) != 0 || version != LOG_VERSION)
+			throw std::runtime_error("ERR Not a Binary Event Log of this Address Width");
+		EventLog text_log;
+		for (uint32_t i = 0; i < level_count; i++) {
+			uint32_t bits[2];
+			binary_reader.read(reinterpret_cast<char *>(bits), sizeof(bits));
+			text_log.decoders.emplace_back(ADDRESS_BITS - bits[0] - bits[1], bits[0], bits[1]);
+		}
+		text_log.write_buffer.resize(BUFFER_BYTES);
+		text_log.log_writer.rdbuf()->pubsetbuf(text_log.write_buffer.data(), BUFFER_BYTES);
+		text_log.log_writer.open(_text_filename);
+		uint64_t event_count{0};
+		LogEvent this_event;
+		while (binary_reader.read(reinterpret_cast<char *>(&this_event), sizeof(this_event))) {
+			DecodedAddress decoded{this_event.address};
+			if (this_event.kind == event_t::event_call && this_event.cache_id != 0)
+				decoded = text_log.decoders.at(this_event.cache_id - 1).decode(this_event.address);
+			text_log.writeText(this_event, decoded);
+			event_count++;
+		}
+		text_log.close();
+		return event_count;
+	}
+
+};
+
+#endif //CODE_EVENTLOG_H
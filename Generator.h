@@ -0,0 +1,143 @@
+#ifndef CODE_GENERATOR_H
+#define CODE_GENERATOR_H
+
+#include "Include.h"
+
+#include <numeric>
+#include <random>
+
+/* Kinds of Synthetic Access Streams
+ *
+ * gsq: Sequential stride, gru: Uniform random, gzf: Zipfian hot set, gpc: Producer/consumer, gpt: Pointer chase
+ */
+enum class generator_t {
+	generate_sequential = 0, generate_random = 1, generate_zipf = 2, generate_producer_consumer = 3,
+	generate_pointer_chase = 4
+};
+
+/* Synthetic Access Streams Produced inside the Process, Instead of tre/twr Lines
+ *
+ * Every stream covers the footprint [base_address, base_address + footprint) and is drawn from one seeded
+ * generator, so the same instructions always produce the same accesses. Accesses are writes with probability
+ * write_percent / 100, except for producer/consumer streams, where producers always write and consumers always read.
+ */
+class AccessGenerator {
+private:
+	std::mt19937_64 random_engine{1};
+	uint32_t write_percent{0};
+	address_t base_address{0};
+
+	/**
+	 * Draw Whether the Next Access is a Write
+	 */
+	[[nodiscard]] task_t drawAccess() {
+		return std::uniform_int_distribution<uint32_t>{0, 99}(random_engine) < write_percent ?
+			   task_t::task_writeAddress : task_t::task_readAddress;
+	}
+
+	/**
+	 * Random Cyclic Order of _block_count Blocks (Sattolo), so a Chase Visits Every Block before Repeating
+	 * @return next[b]: block visited after block b
+	 */
+	[[nodiscard]] std::vector<uint32_t> chaseCycle(const uint32_t &_block_count) {
+		std::vector<uint32_t> order(_block_count);
+		std::iota(order.begin(), order.end(), 0);
+		for (uint32_t i = _block_count - 1; i > 0; i--)
+			std::swap(order[i], order[std::uniform_int_distribution<uint32_t>{0, i - 1}(random_engine)]);
+		std::vector<uint32_t> next(_block_count);
+		for (uint32_t i = 0; i < _block_count; i++)
+			next[order[i]] = order[(i + 1) % _block_count];
+		return next;
+	}
+
+	/**
+	 * Cumulative Zipf Distribution over _block_count Ranks, P(rank r) proportional to 1 / (r + 1)^theta
+	 */
+	[[nodiscard]] static std::vector<double> zipfCdf(const uint32_t &_block_count, const double &_theta) {
+		std::vector<double> cdf(_block_count);
+		double sum{0};
+		for (uint32_t rank = 0; rank < _block_count; rank++)
+			cdf[rank] = sum += 1.0 / std::pow(double(rank) + 1, _theta);
+		for (double &this_probability: cdf)
+			this_probability /= sum;
+		return cdf;
+	}
+
+public:
+
+	/**
+	 * Reseed the Generator and Choose the Write Mix and the Start of the Footprint
+	 */
+	void configure(const uint32_t &_seed, const uint32_t &_write_percent, const address_t &_base_address) {
+		if (_write_percent > 100)
+			throw std::invalid_argument("ERR Write Percent Out-of-range");
+		this->random_engine.seed(_seed);
+		this->write_percent = _write_percent;
+		this->base_address = _base_address;
+	}
+
+	/**
+	 * Produce an Access Stream
+	 * @param _kind Kind of the stream
+	 * @param _count Number of accesses
+	 * @param _footprint Bytes covered by the stream, from base_address
+	 * @param _parameter Stride in bytes (gsq), Zipf exponent in hundredths (gzf), blocks the consumer trails the
+	 *                   producer by (gpc), unused otherwise
+	 * @param _block_size Block size of the system; gzf, gpc and gpt address whole blocks
+	 * @param _on_access Called with [Read or Write][Raw Address][True for a consumer access] of every access, in order
+	 */
+	template<typename AccessHandler>
+	void generate(const generator_t &_kind, const uint32_t &_count, const address_t &_footprint,
+				  const uint32_t &_parameter, const uint32_t &_block_size, AccessHandler &&_on_access) {
+		if (_footprint < _block_size)
+			throw std::invalid_argument("ERR Generator Footprint Smaller than a Block");
+		if (_footprint - 1 > ADDRESS_MAX - this->base_address)
+			throw std::out_of_range("ERR Generator Footprint Exceeds the Address Space");
+		if (_footprint / _block_size > UINT32_MAX)
+			throw std::out_of_range("ERR Generator Footprint Has Too Many Blocks");
+		const uint32_t block_count = _footprint / _block_size;
+		if (_kind == generator_t::generate_sequential) {
+			if (_parameter == 0)
+				throw std::invalid_argument("ERR Generator Stride Must be Positive");
+			uint64_t offset{0};
+			for (uint32_t i = 0; i < _count; i++, offset = (offset + _parameter) % _footprint)
+				_on_access(drawAccess(), this->base_address + address_t(offset), false);
+		} else if (_kind == generator_t::generate_random) {
+			std::uniform_int_distribution<address_t> offsets{0, _footprint - 1};
+			for (uint32_t i = 0; i < _count; i++) {
+				address_t offset = offsets(random_engine);
+				_on_access(drawAccess(), this->base_address + offset, false);
+			}
+		} else if (_kind == generator_t::generate_zipf) {
+			std::vector<double> cdf = zipfCdf(block_count, double(_parameter) / 100);
+			std::vector<uint32_t> rank_blocks(block_count);//hot ranks are scattered over the footprint
+			std::iota(rank_blocks.begin(), rank_blocks.end(), 0);
+			std::shuffle(rank_blocks.begin(), rank_blocks.end(), random_engine);
+			std::uniform_real_distribution<double> probability{0, 1};
+			for (uint32_t i = 0; i < _count; i++) {
+				size_t rank = std::lower_bound(cdf.begin(), cdf.end(), probability(random_engine)) - cdf.begin();
+				uint32_t block = rank_blocks[std::min<size_t>(rank, block_count - 1)];
+				_on_access(drawAccess(), this->base_address + address_t{block} * _block_size, false);
+			}
+		} else if (_kind == generator_t::generate_producer_consumer) {
+			if (_parameter == 0 || _parameter >= block_count)
+				throw std::invalid_argument("ERR Consumer Lag Must be between 1 and the Blocks of the Footprint");
+			for (uint64_t i = 0, produced = 0; i < _count; produced++) {//the ring buffer is the footprint
+				_on_access(task_t::task_writeAddress, this->base_address + address_t(produced % block_count) * _block_size,
+						   false);
+				if (++i < _count && produced >= _parameter) {
+					_on_access(task_t::task_readAddress,
+							   this->base_address + address_t((produced - _parameter) % block_count) * _block_size, true);
+					i++;
+				}
+			}
+		} else if (_kind == generator_t::generate_pointer_chase) {
+			std::vector<uint32_t> next = chaseCycle(block_count);
+			uint32_t block{0};
+			for (uint32_t i = 0; i < _count; i++, block = next[block])
+				_on_access(drawAccess(), this->base_address + address_t{block} * _block_size, false);
+		}
+	}
+};
+
+#endif //CODE_GENERATOR_H
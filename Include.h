@@ -22,12 +22,35 @@
 #include <functional>
 #include <string>
 #include <forward_list>
+#include <limits>
+
+/* Width of Simulated Addresses, Chosen at Build Time (CMake option CACHESIM_ADDRESS_64)
+ *
+ * 32 bits by default; 64-bit builds take addresses of 64-bit processes unfolded. Tags keep only the bits above
+ * the index and offset, in an address_t.
+ */
+#ifdef CACHESIM_ADDRESS_64
+using address_t = uint64_t;
+#else
+using address_t = uint32_t;
+#endif
+constexpr uint32_t ADDRESS_BITS = sizeof(address_t) * 8;
+constexpr address_t ADDRESS_MAX = std::numeric_limits<address_t>::max();
 
 enum class task_t {
-	task_readAddress, task_writeAddress, task_reportHitMiss, task_reportImage, task_halt
+	task_readAddress, task_writeAddress, task_reportHitMiss, task_reportImage, task_halt, task_reportCoherence,
+	task_saveCheckpoint, task_reportCounts, task_reportLatency
 };
 
 
+/* How Each Level's Content Relates to the Levels above it, Chosen by sip
+ *
+ * 0: Non-Inclusive Non-Exclusive (NINE), 1: Inclusive (Back-Invalidation), 2: Exclusive (Victim Swap)
+ */
+enum class inclusion_t {
+	inclusion_nine = 0, inclusion_inclusive = 1, inclusion_exclusive = 2
+};
+
 #define POLICY_WBWA false
 #define POLICY_WTNWA true
 
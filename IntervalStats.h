@@ -0,0 +1,277 @@
+#ifndef CODE_INTERVALSTATS_H
+#define CODE_INTERVALSTATS_H
+
+#include "Include.h"
+
+#include <charconv>
+#include <cstring>
+
+/* Units of the Interval accepted by sis
+ *
+ * 0: Off, 1: Every [interval] Accesses, 2: Every [interval] Clock Cycles
+ */
+enum class interval_t {
+	interval_off = 0, interval_accesses = 1, interval_cycles = 2
+};
+
+/* Counters of One Cache Level over One Interval, Summed over Every Core's Copy of a Private Level */
+struct LevelCount {
+	uint64_t hits{0};
+	uint64_t misses{0};
+	uint64_t evictions{0};
+	uint64_t writebacks{0};//dirty blocks sent to the level below
+};
+
+/* Binary Interval Statistics Format (.stb), Little-Endian
+ *
+ * [Header, 24 Bytes]
+ *   magic        char[8]   "CSSTATS\0"
+ *   version      uint32    1
+ *   level_count  uint32    Number of cache levels
+ *   unit         uint32    interval_t
+ *   length       uint32    Accesses or clock cycles per interval
+ *
+ * [Records, 8 * (3 + 4 * level_count) Bytes Each]
+ *   clock        uint64    Clock when the interval closed (its boundary for cycle intervals)
+ *   accesses     uint64    Accesses run in the interval
+ *   latency      uint64    Clock cycles those accesses took, from issue to completion, summed
+ *   per level    uint64[4] [Hits][Misses][Evictions][Write-Backs] in the interval, L1 first (see Cache::CacheCount)
+ *
+ * The text format (.csv) has the same columns, one row per record.
+ */
+struct StatsHeader {
+	char magic[8]{'C', 'S', 'S', 'T', 'A', 'T', 'S', '\0'};
+	uint32_t version{1};
+	uint32_t level_count{0};
+	uint32_t unit{0};
+	uint32_t length{0};
+};
+
+static_assert(sizeof(StatsHeader) == 24, "Stats Header Must be 24 Bytes");
+
+/* Periodic Statistics of Every Level, Appended to One Buffered File, stats_system.csv (text) or stats_system.stb
+ * (binary)
+ *
+ * Counters are sampled cumulatively by the System when an interval closes, and each record holds the difference
+ * to the previous sample, so a record only covers its own interval. Cycle intervals close at every multiple of
+ * their length, each stamped with that boundary: an access completing past several boundaries closes them all
+ * first (idle intervals as zero records), then counts in the interval it completed in.
+ */
+class IntervalStats {
+private:
+	static constexpr size_t BUFFER_BYTES = 1 << 20;
+
+	interval_t unit{interval_t::interval_off};
+	uint32_t length{0};
+	bool binary{false};
+	std::ofstream stats_writer;
+	std::vector<char> write_buffer;
+
+	//Clock the current interval closes at (cycle intervals only)
+	uint64_t interval_end{0};
+	uint64_t interval_accesses{0};
+	uint64_t interval_latency{0};
+
+	//Cumulative counters of the previous sample, and the record being built
+	std::vector<LevelCount> last_counts;
+	std::vector<uint64_t> record;
+
+	//Text of the Row being Built, Reused to Avoid an Allocation per Row
+	std::string line;
+
+	void appendNumber(const uint64_t &_value) {
+		char digits[24];
+		auto result = std::to_chars(digits, digits + sizeof(digits), _value);
+		line.append(digits, result.ptr);
+	}
+
+	/**
+	 * Write the Column Names of the Text Format
+	 */
+	void writeTextHeader(const size_t &_level_count) {
+		line = "CLOCK,ACCESSES,LATENCY";
+		for (size_t level = 1; level <= _level_count; level++)
+			for (const char *this_column: {"_HITS", "_MISSES", "_EVICTIONS", "_WRITEBACKS"}) {
+				line += ",L";
+				appendNumber(level);
+				line += this_column;
+			}
+		line += '\n';
+		stats_writer.write(line.data(), static_cast<std::streamsize>(line.size()));
+	}
+
+	/**
+	 * Write One Record, as Raw Values or as a Row of Text
+	 */
+	void writeRecord(const uint64_t *_values, const size_t &_count) {
+		if (this->binary) {
+			stats_writer.write(reinterpret_cast<const char *>(_values),
+							   static_cast<std::streamsize>(_count * sizeof(uint64_t)));
+			return;
+		}
+		line.clear();
+		for (size_t i = 0; i < _count; i++) {
+			if (i != 0) line += ',';
+			appendNumber(_values[i]);
+		}
+		line += '\n';
+		stats_writer.write(line.data(), static_cast<std::streamsize>(line.size()));
+	}
+
+	void openFile(const std::string &_filename) {
+		this->write_buffer.resize(BUFFER_BYTES);
+		this->stats_writer.rdbuf()->pubsetbuf(this->write_buffer.data(), BUFFER_BYTES);
+		if (this->binary)
+			this->stats_writer.open(_filename, std::ios::binary | std::ios::trunc);
+		else
+			this->stats_writer.open(_filename);
+		if (!this->stats_writer.is_open())
+			throw std::runtime_error("ERR Cannot Open Stats File " + _filename);
+	}
+
+public:
+
+	/**
+	 * Choose the Interval and Format
+	 * Warning: Takes effect when the file is opened
+	 * @param _unit Unit of the interval
+	 * @param _length Accesses or clock cycles per interval
+	 * @param _binary True to write stats_system.stb instead of stats_system.csv
+	 */
+	void configure(const interval_t &_unit, const uint32_t &_length, const bool &_binary) {
+		if (stats_writer.is_open())
+			throw std::invalid_argument("ERR Interval Stats Set after Stats Opened");
+		if (_unit != interval_t::interval_off && _length == 0)
+			throw std::invalid_argument("ERR Stats Interval Must be Positive");
+		this->unit = _unit;
+		this->length = _length;
+		this->binary = _binary;
+	}
+
+	[[nodiscard]] bool isEnabled() const {
+		return this->unit != interval_t::interval_off;
+	}
+
+	/**
+	 * Check if the Stats File is Open with Cycle Intervals, whose Boundaries the System Closes with the Counters
+	 * Sampled before the Access Running
+	 */
+	[[nodiscard]] bool isByCycles() const {
+		return stats_writer.is_open() && this->unit == interval_t::interval_cycles;
+	}
+
+	/**
+	 * Open the Stats File, unless Interval Stats are Off
+	 * @param _counts Cumulative counters of every level when the first interval opens, L1 first
+	 * @param _clock Clock when the first interval opens
+	 */
+	void open(const std::vector<LevelCount> &_counts, const uint64_t &_clock) {
+		if (stats_writer.is_open() || !this->isEnabled()) return;
+		this->openFile(this->binary ? "stats_system.stb" : "stats_system.csv");
+		if (this->binary) {
+			StatsHeader header;
+			header.level_count = _counts.size();
+			header.unit = uint32_t(this->unit);
+			header.length = this->length;
+			stats_writer.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		} else
+			this->writeTextHeader(_counts.size());
+		this->last_counts = _counts;
+		this->record.resize(3 + 4 * _counts.size());
+		this->interval_end = (_clock / this->length + 1) * this->length;
+		this->interval_accesses = 0;
+		this->interval_latency = 0;
+	}
+
+	/**
+	 * Close Every Cycle Interval Ending at or before a Clock, Stamping Each with its Boundary
+	 * Intervals after the first get no access and no counter change
+	 * @param _counts Cumulative counters of every level before the access completing at _clock ran, L1 first
+	 * @param _clock Clock the access completed at
+	 */
+	void closeBoundaries(const std::vector<LevelCount> &_counts, const uint64_t &_clock) {
+		if (!this->isByCycles()) return;
+		while (_clock >= this->interval_end)
+			this->close(_counts, this->interval_end);
+	}
+
+	/**
+	 * Count One Completed Access, in the Current Interval (Cycle Intervals it Passed must be Closed First)
+	 * @param _latency Clock cycles from its issue to its completion
+	 * @return True if an interval of accesses is full, and the System should sample its counters for close()
+	 */
+	[[nodiscard]] bool access(const uint64_t &_latency) {
+		if (!stats_writer.is_open()) return false;
+		this->interval_accesses++;
+		this->interval_latency += _latency;
+		return this->unit == interval_t::interval_accesses && this->interval_accesses == this->length;
+	}
+
+	/**
+	 * Close the Current Interval, Appending its Record
+	 * @param _counts Cumulative counters of every level now, L1 first
+	 * @param _clock Clock the record is stamped with (the boundary of a cycle interval)
+	 */
+	void close(const std::vector<LevelCount> &_counts, const uint64_t &_clock) {
+		if (!stats_writer.is_open()) return;
+		this->record[0] = _clock;
+		this->record[1] = this->interval_accesses;
+		this->record[2] = this->interval_latency;
+		for (size_t level = 0; level < _counts.size(); level++) {
+			this->record[3 + 4 * level] = _counts[level].hits - this->last_counts[level].hits;
+			this->record[4 + 4 * level] = _counts[level].misses - this->last_counts[level].misses;
+			this->record[5 + 4 * level] = _counts[level].evictions - this->last_counts[level].evictions;
+			this->record[6 + 4 * level] = _counts[level].writebacks - this->last_counts[level].writebacks;
+		}
+		this->writeRecord(this->record.data(), this->record.size());
+		this->last_counts = _counts;
+		this->interval_end = (_clock / this->length + 1) * this->length;
+		this->interval_accesses = 0;
+		this->interval_latency = 0;
+	}
+
+	/**
+	 * Close the Cycle Intervals Ending by the End of the Run, the Last, Partial Interval if it Ran Any Access, and
+	 * the Stats File
+	 * @param _counts Cumulative counters of every level now, L1 first
+	 * @param _clock Clock now
+	 */
+	void finish(const std::vector<LevelCount> &_counts, const uint64_t &_clock) {
+		if (!stats_writer.is_open()) return;
+		this->closeBoundaries(_counts, _clock);
+		if (this->interval_accesses != 0)
+			this->close(_counts, _clock);
+		stats_writer.close();
+	}
+
+	/**
+	 * Print Binary Interval Stats as the Text the Same Run would have Written
+	 * @param _binary_filename Binary stats (.stb)
+	 * @param _text_filename Text stats to be written (.csv)
+	 * @return Number of records printed
+	 */
+	static uint64_t printBinaryStats(const std::string &_binary_filename, const std::string &_text_filename) {
+		std::ifstream binary_reader{_binary_filename, std::ios::binary};
+		if (!binary_reader.is_open())
+			throw std::runtime_error("ERR Cannot Open Binary Stats " + _binary_filename);
+		StatsHeader header, expected_header;
+		binary_reader.read(reinterpret_cast<char *>(&header), sizeof(header));
+		if (!binary_reader || std::memcmp(header.magic, expected_header.magic, sizeof(header.magic)) != 0 ||
+			header.version != expected_header.version)
+			throw std::runtime_error("ERR Not a Binary Stats File");
+		IntervalStats text_stats;
+		text_stats.openFile(_text_filename);
+		text_stats.writeTextHeader(header.level_count);
+		std::vector<uint64_t> values(3 + 4 * size_t{header.level_count});
+		uint64_t record_count{0};
+		while (binary_reader.read(reinterpret_cast<char *>(values.data()),
+								  static_cast<std::streamsize>(values.size() * sizeof(uint64_t)))) {
+			text_stats.writeRecord(values.data(), values.size());
+			record_count++;
+		}
+		text_stats.stats_writer.close();
+		return record_count;
+	}
+};
+
+#endif //CODE_INTERVALSTATS_H
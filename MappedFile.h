@@ -0,0 +1,62 @@
+#ifndef CODE_MAPPEDFILE_H
+#define CODE_MAPPEDFILE_H
+
+#include "Include.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Read-Only Memory Mapping of a Whole File
+ *
+ * Unmapped when destroyed. The kernel is told access is sequential so it reads ahead aggressively.
+ */
+class MappedFile {
+private:
+	const char *data{nullptr};
+	size_t length{0};
+
+public:
+
+	explicit MappedFile(const std::string &_filename) {
+		int file_descriptor = ::open(_filename.c_str(), O_RDONLY);
+		if (file_descriptor < 0)
+			throw std::runtime_error("ERR Cannot Open File " + _filename);
+		struct stat file_status{};
+		if (::fstat(file_descriptor, &file_status) != 0) {
+			::close(file_descriptor);
+			throw std::runtime_error("ERR Cannot Stat File " + _filename);
+		}
+		this->length = file_status.st_size;
+		if (this->length > 0) {
+			void *mapped = ::mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+			if (mapped == MAP_FAILED) {
+				::close(file_descriptor);
+				throw std::runtime_error("ERR Cannot Map File " + _filename);
+			}
+			::madvise(mapped, this->length, MADV_SEQUENTIAL);
+			this->data = static_cast<const char *>(mapped);
+		}
+		::close(file_descriptor);
+	}
+
+	MappedFile(const MappedFile &) = delete;
+
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	~MappedFile() {
+		if (this->data != nullptr)
+			::munmap(const_cast<char *>(this->data), this->length);
+	}
+
+	[[nodiscard]] const char *getData() const {
+		return this->data;
+	}
+
+	[[nodiscard]] size_t getLength() const {
+		return this->length;
+	}
+};
+
+#endif //CODE_MAPPEDFILE_H
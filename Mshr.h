@@ -0,0 +1,115 @@
+#ifndef CODE_MSHR_H
+#define CODE_MSHR_H
+
+#include "Include.h"
+#include "Checkpoint.h"
+
+/* Miss Status Holding Registers of One Cache Level
+ *
+ * Each register tracks one outstanding miss: the block and the clock its fill completes. A miss takes a free
+ * register, waiting for the earliest fill to complete if all are busy; an access to a block whose fill is
+ * still outstanding merges into it and completes with it. Registers are few, so they are scanned linearly.
+ */
+class MshrFile {
+public:
+	struct MshrCount {
+		uint64_t misses{0};
+		uint64_t merges{0};
+		uint64_t full_stalls{0};
+		uint64_t stall_cycles{0};
+	};
+
+private:
+	static constexpr uint64_t FILL_PENDING = UINT64_MAX;
+
+	//[Block][Clock the fill completes]; free once that clock has passed
+	std::vector<std::pair<address_t, uint64_t>> registers;
+	MshrCount counts;
+
+public:
+
+	/**
+	 * Set the Number of Registers
+	 */
+	void configure(const uint32_t &_register_count) {
+		if (_register_count == 0)
+			throw std::invalid_argument("ERR MSHR Count Must be Positive");
+		this->registers.assign(_register_count, {0, 0});
+	}
+
+	[[nodiscard]] bool isEnabled() const {
+		return !this->registers.empty();
+	}
+
+	[[nodiscard]] const MshrCount &getCounts() const {
+		return this->counts;
+	}
+
+	void resetCounts() {
+		this->counts = {};
+	}
+
+	/**
+	 * Find an Outstanding Fill of a Block, Merging the Access into it
+	 * @param _block Block accessed
+	 * @param _clock Clock of the access
+	 * @return Clock the fill completes, 0 if the block has no fill outstanding
+	 */
+	uint64_t merge(const address_t &_block, const uint64_t &_clock) {
+		for (const auto &this_register: this->registers)
+			if (this_register.first == _block && this_register.second > _clock) {
+				this->counts.merges++;
+				return this_register.second;
+			}
+		return 0;
+	}
+
+	/**
+	 * Take a Register for a Miss, Waiting for the Earliest Fill to Complete if All are Busy
+	 * @param _block Block missed
+	 * @param _clock Clock of the miss, moved to when a register frees up
+	 * @return Register taken, to be released with the clock its fill completes
+	 */
+	size_t acquire(const address_t &_block, uint64_t &_clock) {
+		size_t earliest{0};
+		for (size_t i = 1; i < this->registers.size(); i++)
+			if (this->registers[i].second < this->registers[earliest].second)
+				earliest = i;
+		uint64_t free_clock = this->registers[earliest].second;
+		if (free_clock == FILL_PENDING)
+			throw std::runtime_error("ERR No MSHR Can Free Up");
+		if (free_clock > _clock) {
+			this->counts.full_stalls++;
+			this->counts.stall_cycles += free_clock - _clock;
+			_clock = free_clock;
+		}
+		this->counts.misses++;
+		this->registers[earliest] = {_block, FILL_PENDING};
+		return earliest;
+	}
+
+	/**
+	 * Record when the Fill of a Register Completes
+	 */
+	void release(const size_t &_register, const uint64_t &_fill_clock) {
+		this->registers[_register].second = _fill_clock;
+	}
+
+	/**
+	 * Write the Registers and Counters to a Checkpoint
+	 */
+	void saveState(CheckpointWriter &_writer) const {
+		_writer.write(this->counts);
+		_writer.writeVector(this->registers);
+	}
+
+	/**
+	 * Restore the Registers and Counters into a File of as Many Registers
+	 */
+	void loadState(CheckpointReader &_reader) {
+		this->counts = _reader.read<MshrCount>();
+		_reader.readArray(this->registers.data(), this->registers.size());
+	}
+};
+
+#endif //CODE_MSHR_H
@@ -0,0 +1,283 @@
+#ifndef CODE_PREFETCHER_H
+#define CODE_PREFETCHER_H
+
+#include "Include.h"
+#include "Checkpoint.h"
+
+#include <deque>
+
+/* Prefetchers accepted by spf
+ *
+ * 0: Off, 1: Next-Line, 2: Stride (PC-less, per 4 KiB region), 3: Stream Buffer
+ */
+enum class prefetcher_t {
+	prefetch_off = 0, prefetch_next_line = 1, prefetch_stride = 2, prefetch_stream_buffer = 3
+};
+
+/* Hardware Prefetcher of One Cache Level, Working on Block Numbers (Address >> Offset Bits)
+ *
+ * Next-line and stride prefetchers fill their cache directly, so their blocks compete with demand blocks;
+ * a stream buffer holds the blocks following the latest miss apart from the cache, and hands one over only when
+ * a demand read misses on it. Every prefetched block becomes ready a fetch latency after it was issued; a demand
+ * arriving before then waits for the rest (a late prefetch).
+ *
+ * Counters: issued prefetches; useful (demanded before being evicted or dropped); late (useful, but demanded
+ * before ready); useless (evicted or dropped unused); pollution (demand misses on blocks a prefetch evicted,
+ * approximate: only the last such block of each slot of a small direct-mapped table is remembered); demand misses
+ * left (misses prefetching did not cover).
+ */
+class Prefetcher {
+public:
+	struct PrefetchCount {
+		uint64_t issued{0};
+		uint64_t useful{0};
+		uint64_t late{0};
+		uint64_t useless{0};
+		uint64_t pollution{0};
+		uint64_t demand_misses{0};
+	};
+
+private:
+	prefetcher_t kind{prefetcher_t::prefetch_off};
+	uint32_t degree{0};
+	PrefetchCount counts;
+
+	//Prefetched blocks in the cache not demanded yet: block -> clock when ready
+	std::unordered_map<address_t, uint64_t> pending_blocks;
+
+	//Blocks a prefetch evicted and no demand has missed on since, direct-mapped on the block, ADDRESS_MAX if empty
+	static constexpr size_t EVICTED_ENTRIES = 1024;
+	std::array<address_t, EVICTED_ENTRIES> evicted_table{};
+
+	//Stride detector, direct-mapped on the 4 KiB region of the block
+	struct StrideEntry {
+		address_t region{ADDRESS_MAX};
+		address_t last_block{0};
+		int64_t stride{0};
+	};
+	static constexpr size_t STRIDE_ENTRIES = 64;
+	std::array<StrideEntry, STRIDE_ENTRIES> stride_table{};
+	uint32_t region_shift{0};
+
+	/**
+	 * Drop a Block from the Table of Blocks a Prefetch Evicted
+	 * @return True if the table held it
+	 */
+	bool forgetEvicted(const address_t &_block) {
+		address_t &entry = this->evicted_table[_block % EVICTED_ENTRIES];
+		if (entry != _block)
+			return false;
+		entry = ADDRESS_MAX;
+		return true;
+	}
+
+	//Stream buffer: [block][clock when ready], head first
+	std::deque<std::pair<address_t, uint64_t>> stream_buffer;
+
+public:
+
+	Prefetcher() {
+		this->evicted_table.fill(ADDRESS_MAX);
+	}
+
+	/**
+	 * Choose the Prefetcher
+	 * @param _kind Prefetcher (see prefetcher_t)
+	 * @param _degree Blocks prefetched ahead (the depth of a stream buffer)
+	 * @param _offset_bits Offset bits of the cache, to find 4 KiB regions of blocks
+	 */
+	void configure(const prefetcher_t &_kind, const uint32_t &_degree, const uint32_t &_offset_bits) {
+		if (_kind != prefetcher_t::prefetch_off && _degree == 0)
+			throw std::invalid_argument("ERR Prefetch Degree Must be Positive");
+		this->kind = _kind;
+		this->degree = _degree;
+		this->region_shift = _offset_bits < 12 ? 12 - _offset_bits : 0;
+	}
+
+	[[nodiscard]] bool isEnabled() const {
+		return this->kind != prefetcher_t::prefetch_off;
+	}
+
+	[[nodiscard]] bool isStreamBuffer() const {
+		return this->kind == prefetcher_t::prefetch_stream_buffer;
+	}
+
+	[[nodiscard]] const PrefetchCount &getCounts() const {
+		return this->counts;
+	}
+
+	void resetCounts() {
+		this->counts = {};
+	}
+
+	/**
+	 * Account a Demand Access to the Cache
+	 * @param _block Block demanded
+	 * @param _hit If the cache held the block
+	 * @param _clock Clock of the demand
+	 * @return [If a prefetch brought the block][Clock cycles the demand waits for it, if late]
+	 */
+	std::pair<bool, uint64_t> demand(const address_t &_block, const bool &_hit, const uint64_t &_clock) {
+		bool prefetched{false};
+		uint64_t wait{0};
+		auto pending = this->pending_blocks.find(_block);
+		if (pending != this->pending_blocks.end()) {
+			if (_hit) {
+				prefetched = true;
+				this->counts.useful++;
+				if (pending->second > _clock) {
+					this->counts.late++;
+					wait = pending->second - _clock;
+				}
+			} else//the block left the cache some other way (e.g. a coherence invalidation)
+				this->counts.useless++;
+			this->pending_blocks.erase(pending);
+		}
+		if (!_hit) {
+			this->counts.pollution += this->forgetEvicted(_block);
+			this->counts.demand_misses++;
+		}
+		return {prefetched, wait};
+	}
+
+	/**
+	 * Blocks to Prefetch after a Demand Access (Next-Line and Stride Prefetchers)
+	 * @param _block Block demanded
+	 * @param _hit If the cache held the block
+	 * @param _prefetched_hit If the demand hit a block brought by a prefetch (keeps next-line streams going)
+	 * @param _targets Filled with the blocks to prefetch
+	 */
+	void train(const address_t &_block, const bool &_hit, const bool &_prefetched_hit, std::vector<address_t> &_targets) {
+		_targets.clear();
+		if (this->kind == prefetcher_t::prefetch_next_line) {
+			if (_hit && !_prefetched_hit) return;
+			for (uint32_t i = 1; i <= this->degree; i++)
+				_targets.push_back(_block + i);
+		} else if (this->kind == prefetcher_t::prefetch_stride) {
+			address_t region = _block >> this->region_shift;
+			StrideEntry &entry = this->stride_table[region % STRIDE_ENTRIES];
+			if (entry.region != region) {
+				entry = StrideEntry{region, _block, 0};
+				return;
+			}
+			int64_t stride = int64_t(_block) - int64_t(entry.last_block);
+			entry.last_block = _block;
+			if (stride == 0) return;
+			if (stride != entry.stride) {//prefetch only once the same stride is seen twice in a row
+				entry.stride = stride;
+				return;
+			}
+			for (uint32_t i = 1; i <= this->degree; i++) {
+				int64_t target = int64_t(_block) + stride * i;
+				if (target < 0 || uint64_t(target) > ADDRESS_MAX) break;
+				_targets.push_back(address_t(target));
+			}
+		}
+	}
+
+	/**
+	 * Record a Prefetch Filling the Cache
+	 * @param _block Block prefetched
+	 * @param _ready_clock Clock when its data arrives
+	 */
+	void filled(const address_t &_block, const uint64_t &_ready_clock) {
+		this->counts.issued++;
+		this->pending_blocks[_block] = _ready_clock;
+		(void) this->forgetEvicted(_block);
+	}
+
+	/**
+	 * Record a Block Leaving the Cache
+	 * @param _block Block evicted
+	 * @param _by_prefetch True if a prefetch fill evicted it
+	 */
+	void evicted(const address_t &_block, const bool &_by_prefetch) {
+		bool was_pending = this->pending_blocks.erase(_block) != 0;
+		this->counts.useless += was_pending;
+		if (_by_prefetch && !was_pending)
+			this->evicted_table[_block % EVICTED_ENTRIES] = _block;
+	}
+
+	/**
+	 * Offer a Demand Miss to the Stream Buffer
+	 * If the buffer holds the block, it hands it over and drops the blocks ahead of it (skipped by the stream);
+	 * otherwise the buffer is flushed, to restart from the next block
+	 * @param _block Block missed
+	 * @param _ready_clock Set to the clock the handed-over block is ready at
+	 * @return True if the buffer supplies the block
+	 */
+	bool takeStreamBlock(const address_t &_block, uint64_t &_ready_clock) {
+		auto found = std::find_if(this->stream_buffer.begin(), this->stream_buffer.end(),
+								  [&_block](const std::pair<address_t, uint64_t> &_entry) {
+									  return _entry.first == _block;
+								  });
+		if (found == this->stream_buffer.end()) {
+			this->counts.useless += this->stream_buffer.size();
+			this->stream_buffer.clear();
+			return false;
+		}
+		_ready_clock = found->second;
+		this->counts.useless += found - this->stream_buffer.begin();
+		this->stream_buffer.erase(this->stream_buffer.begin(), found + 1);
+		this->counts.useful++;
+		return true;
+	}
+
+	/**
+	 * Blocks the Stream Buffer Needs to Fetch to be Full Again, Following _block
+	 */
+	void streamTargets(const address_t &_block, std::vector<address_t> &_targets) const {
+		_targets.clear();
+		address_t next_block = this->stream_buffer.empty() ? _block + 1 : this->stream_buffer.back().first + 1;
+		for (size_t i = this->stream_buffer.size(); i < this->degree; i++)
+			_targets.push_back(next_block++);
+	}
+
+	/**
+	 * Append a Fetched Block to the Stream Buffer
+	 */
+	void streamFilled(const address_t &_block, const uint64_t &_ready_clock) {
+		this->counts.issued++;
+		this->stream_buffer.emplace_back(_block, _ready_clock);
+	}
+
+	/**
+	 * Count a Late Stream Buffer Block
+	 */
+	void streamLate() {
+		this->counts.late++;
+	}
+
+	/**
+	 * Write the Training State, Blocks in Flight and Counters to a Checkpoint
+	 */
+	void saveState(CheckpointWriter &_writer) const {
+		_writer.write(uint32_t(this->kind));
+		_writer.write(this->degree);
+		_writer.write(this->counts);
+		_writer.writeVector(std::vector<std::pair<address_t, uint64_t>>(this->pending_blocks.begin(),
+																		 this->pending_blocks.end()));
+		_writer.writeArray(this->evicted_table.data(), this->evicted_table.size());
+		_writer.writeArray(this->stride_table.data(), this->stride_table.size());
+		_writer.writeVector(std::vector<std::pair<address_t, uint64_t>>(this->stream_buffer.begin(),
+																		 this->stream_buffer.end()));
+	}
+
+	/**
+	 * Restore the State Written by saveState into a Prefetcher of the Same Kind and Degree
+	 */
+	void loadState(CheckpointReader &_reader) {
+		_reader.expect(uint32_t(this->kind));
+		_reader.expect(this->degree);
+		this->counts = _reader.read<PrefetchCount>();
+		std::vector<std::pair<address_t, uint64_t>> blocks_and_clocks;
+		_reader.readVector(blocks_and_clocks);
+		this->pending_blocks = {blocks_and_clocks.begin(), blocks_and_clocks.end()};
+		_reader.readArray(this->evicted_table.data(), this->evicted_table.size());
+		_reader.readArray(this->stride_table.data(), this->stride_table.size());
+		_reader.readVector(blocks_and_clocks);
+		this->stream_buffer = {blocks_and_clocks.begin(), blocks_and_clocks.end()};
+	}
+};
+
+#endif //CODE_PREFETCHER_H
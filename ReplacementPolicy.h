@@ -0,0 +1,363 @@
+#ifndef CODE_REPLACEMENTPOLICY_H
+#define CODE_REPLACEMENTPOLICY_H
+
+#include "Include.h"
+#include "Checkpoint.h"
+
+/* Replacement Policy Numbers accepted by srp
+ *
+ * 1: LRU, 2: Tree-PLRU, 3: SRRIP, 4: BRRIP, 5: Random, 6: FIFO
+ */
+enum class replacement_t {
+	repl_lru = 1, repl_tree_plru = 2, repl_srrip = 3, repl_brrip = 4, repl_random = 5, repl_fifo = 6
+};
+
+/* Interface of a Replacement Policy of One Cache
+ *
+ * The Cache calls touch() on every hit, insert() on every fill and victim() only when a set is full.
+ * Each policy keeps its own compact per-set metadata, laid out set-major like the TagStore.
+ */
+class ReplacementPolicy {
+public:
+	virtual ~ReplacementPolicy() = default;
+
+	/**
+	 * Allocate Metadata for All Sets
+	 * @param _set_count Number of Sets
+	 * @param _assoc Number of Ways per Set
+	 */
+	virtual void init(const uint32_t &_set_count, const uint32_t &_assoc) = 0;
+
+	/**
+	 * Record a Hit on a Way
+	 */
+	virtual void touch(const uint32_t &_set, const uint32_t &_way) = 0;
+
+	/**
+	 * Record a Fill of a Way
+	 */
+	virtual void insert(const uint32_t &_set, const uint32_t &_way) = 0;
+
+	/**
+	 * Choose the Way to Evict from a Full Set
+	 * @return Way to be evicted
+	 */
+	[[nodiscard]] virtual uint32_t victim(const uint32_t &_set) = 0;
+
+	/**
+	 * Get the Policy State of a Way (For Printing Purpose)
+	 * @return LRU/FIFO: position from most recent (0 = newest), Tree-PLRU: 1 if next victim, RRIP: RRPV, Random: 0
+	 */
+	[[nodiscard]] virtual uint32_t getState(const uint32_t &_set, const uint32_t &_way) const = 0;
+
+	/**
+	 * Get the Short Name of this Policy, used as the Column Title of Cache Images
+	 */
+	[[nodiscard]] virtual std::string getName() const = 0;
+
+	/**
+	 * Write the Per-Set Metadata (and any Generator State) to a Checkpoint
+	 */
+	virtual void saveState(CheckpointWriter &_writer) const = 0;
+
+	/**
+	 * Restore the State Written by saveState, into a Policy Initialized with the Same Dimensions
+	 */
+	virtual void loadState(CheckpointReader &_reader) = 0;
+};
+
+/* Doubly-Linked Recency List per Set, with 16-bit Way Links
+ *
+ * head is the newest way, tail the oldest; moving a way to the head and picking the tail are both O(1).
+ * LRU moves a way on hit and fill, FIFO on fill only.
+ */
+class RecencyListPolicy : public ReplacementPolicy {
+private:
+	uint32_t assoc{0};
+	bool move_on_hit{true};
+	std::vector<uint16_t> prev_way;
+	std::vector<uint16_t> next_way;
+	std::vector<uint16_t> head_way;
+	std::vector<uint16_t> tail_way;
+
+	void moveToHead(const uint32_t &_set, const uint32_t &_way) {
+		uint16_t &head = head_way[_set];
+		if (head == _way) return;
+		const size_t base = size_t{_set} * assoc;
+		uint16_t before = prev_way[base + _way];
+		uint16_t after = next_way[base + _way];
+		next_way[base + before] = after;//unlink (way is not head, so it has a previous way)
+		if (tail_way[_set] == _way)
+			tail_way[_set] = before;
+		else
+			prev_way[base + after] = before;
+		next_way[base + _way] = head;//relink in front of the head
+		prev_way[base + head] = _way;
+		head = _way;
+	}
+
+public:
+
+	explicit RecencyListPolicy(const bool &_move_on_hit) {
+		this->move_on_hit = _move_on_hit;
+	}
+
+	void init(const uint32_t &_set_count, const uint32_t &_assoc) override {
+		if (_assoc > UINT16_MAX + 1)
+			throw std::invalid_argument("ERR Set Associativity Too Large for Replacement State");
+		this->assoc = _assoc;
+		prev_way.resize(size_t{_set_count} * _assoc);
+		next_way.resize(size_t{_set_count} * _assoc);
+		head_way.assign(_set_count, 0);
+		tail_way.assign(_set_count, _assoc - 1);
+		for (size_t set = 0; set < _set_count; set++)
+			for (uint32_t way = 0; way < _assoc; way++) {
+				prev_way[set * _assoc + way] = way == 0 ? 0 : way - 1;
+				next_way[set * _assoc + way] = way + 1 == _assoc ? way : way + 1;
+			}
+	}
+
+	void touch(const uint32_t &_set, const uint32_t &_way) override {
+		if (move_on_hit)
+			moveToHead(_set, _way);
+	}
+
+	void insert(const uint32_t &_set, const uint32_t &_way) override {
+		moveToHead(_set, _way);
+	}
+
+	[[nodiscard]] uint32_t victim(const uint32_t &_set) override {
+		return tail_way[_set];
+	}
+
+	[[nodiscard]] uint32_t getState(const uint32_t &_set, const uint32_t &_way) const override {
+		uint32_t rank{0};
+		for (uint16_t way = head_way[_set]; way != _way; way = next_way[size_t{_set} * assoc + way])
+			rank++;
+		return rank;
+	}
+
+	[[nodiscard]] std::string getName() const override {
+		return move_on_hit ? "LRU" : "FIFO";
+	}
+
+	void saveState(CheckpointWriter &_writer) const override {
+		_writer.writeVector(prev_way);
+		_writer.writeVector(next_way);
+		_writer.writeVector(head_way);
+		_writer.writeVector(tail_way);
+	}
+
+	void loadState(CheckpointReader &_reader) override {
+		_reader.readArray(prev_way.data(), prev_way.size());
+		_reader.readArray(next_way.data(), next_way.size());
+		_reader.readArray(head_way.data(), head_way.size());
+		_reader.readArray(tail_way.data(), tail_way.size());
+	}
+};
+
+/* Tree Pseudo-LRU, (Associativity - 1) Bits per Set
+ *
+ * Node n (1-based heap order) stores which half the next victim lies in: 0 left, 1 right.
+ * A hit or fill flips the nodes on the way's path to point away from it.
+ */
+class TreePLRUPolicy : public ReplacementPolicy {
+private:
+	uint32_t levels{0};
+	uint32_t words_per_set{0};
+	std::vector<uint64_t> tree_bits;
+
+	[[nodiscard]] bool getNode(const uint32_t &_set, const uint32_t &_node) const {
+		size_t bit = _node - 1;
+		return (tree_bits[size_t{_set} * words_per_set + (bit >> 6)] >> (bit & 63)) & 1;
+	}
+
+	void setNode(const uint32_t &_set, const uint32_t &_node, const bool &_right) {
+		size_t bit = _node - 1;
+		uint64_t &word = tree_bits[size_t{_set} * words_per_set + (bit >> 6)];
+		word = _right ? (word | (uint64_t{1} << (bit & 63))) : (word & ~(uint64_t{1} << (bit & 63)));
+	}
+
+	[[nodiscard]] uint32_t findVictim(const uint32_t &_set) const {
+		uint32_t node{1}, way{0};
+		for (uint32_t level = 0; level < levels; level++) {
+			bool right = getNode(_set, node);
+			way = (way << 1) | right;
+			node = (node << 1) | right;
+		}
+		return way;
+	}
+
+public:
+
+	void init(const uint32_t &_set_count, const uint32_t &_assoc) override {
+		if (_assoc == 0 || (_assoc & (_assoc - 1)) != 0)
+			throw std::invalid_argument("ERR Tree-PLRU Needs a Power-of-Two Set Associativity");
+		this->levels = lround(log2l(_assoc));
+		this->words_per_set = (_assoc - 1 + 63) / 64;
+		tree_bits.assign(size_t{_set_count} * words_per_set, 0);
+	}
+
+	void touch(const uint32_t &_set, const uint32_t &_way) override {
+		uint32_t node{1};
+		for (uint32_t level = levels; level-- > 0;) {
+			bool right = (_way >> level) & 1;
+			setNode(_set, node, !right);
+			node = (node << 1) | right;
+		}
+	}
+
+	void insert(const uint32_t &_set, const uint32_t &_way) override {
+		this->touch(_set, _way);
+	}
+
+	[[nodiscard]] uint32_t victim(const uint32_t &_set) override {
+		return findVictim(_set);
+	}
+
+	[[nodiscard]] uint32_t getState(const uint32_t &_set, const uint32_t &_way) const override {
+		return findVictim(_set) == _way;
+	}
+
+	[[nodiscard]] std::string getName() const override {
+		return "PLRU";
+	}
+
+	void saveState(CheckpointWriter &_writer) const override {
+		_writer.writeVector(tree_bits);
+	}
+
+	void loadState(CheckpointReader &_reader) override {
+		_reader.readArray(tree_bits.data(), tree_bits.size());
+	}
+};
+
+/* Re-Reference Interval Prediction with 2-bit RRPV per Way
+ *
+ * SRRIP inserts at a long re-reference interval (2), BRRIP at distant (3) except once every 32 fills.
+ * A hit predicts near re-reference (0). The victim is the first way at distant, aging the set until one is.
+ */
+class RRIPPolicy : public ReplacementPolicy {
+private:
+	static constexpr uint8_t RRPV_MAX = 3;
+	static constexpr uint32_t BIMODAL_PERIOD = 32;
+	uint32_t assoc{0};
+	bool bimodal{false};
+	uint64_t fill_count{0};
+	std::vector<uint8_t> rrpv;
+
+public:
+
+	explicit RRIPPolicy(const bool &_bimodal) {
+		this->bimodal = _bimodal;
+	}
+
+	void init(const uint32_t &_set_count, const uint32_t &_assoc) override {
+		this->assoc = _assoc;
+		rrpv.assign(size_t{_set_count} * _assoc, RRPV_MAX);
+	}
+
+	void touch(const uint32_t &_set, const uint32_t &_way) override {
+		rrpv[size_t{_set} * assoc + _way] = 0;
+	}
+
+	void insert(const uint32_t &_set, const uint32_t &_way) override {
+		bool distant = bimodal && (fill_count++ % BIMODAL_PERIOD) != 0;
+		rrpv[size_t{_set} * assoc + _way] = distant ? RRPV_MAX : RRPV_MAX - 1;
+	}
+
+	[[nodiscard]] uint32_t victim(const uint32_t &_set) override {
+		uint8_t *set_rrpv = &rrpv[size_t{_set} * assoc];
+		uint8_t oldest = *std::max_element(set_rrpv, set_rrpv + assoc);
+		if (oldest < RRPV_MAX)//age the whole set at once instead of one step per round
+			for (uint32_t way = 0; way < assoc; way++)
+				set_rrpv[way] += RRPV_MAX - oldest;
+		return std::find(set_rrpv, set_rrpv + assoc, RRPV_MAX) - set_rrpv;
+	}
+
+	[[nodiscard]] uint32_t getState(const uint32_t &_set, const uint32_t &_way) const override {
+		return rrpv[size_t{_set} * assoc + _way];
+	}
+
+	[[nodiscard]] std::string getName() const override {
+		return bimodal ? "BRRIP" : "SRRIP";
+	}
+
+	void saveState(CheckpointWriter &_writer) const override {
+		_writer.write(fill_count);
+		_writer.writeVector(rrpv);
+	}
+
+	void loadState(CheckpointReader &_reader) override {
+		fill_count = _reader.read<uint64_t>();
+		_reader.readArray(rrpv.data(), rrpv.size());
+	}
+};
+
+/* Random Replacement, No Per-Set Metadata
+ *
+ * Uses a fixed-seed xorshift generator so runs are reproducible.
+ */
+class RandomPolicy : public ReplacementPolicy {
+private:
+	uint32_t assoc{0};
+	uint64_t rng_state{0x9E3779B97F4A7C15ULL};
+
+public:
+
+	void init(const uint32_t &/*_set_count*/, const uint32_t &_assoc) override {
+		this->assoc = _assoc;
+	}
+
+	void touch(const uint32_t &/*_set*/, const uint32_t &/*_way*/) override {}
+
+	void insert(const uint32_t &/*_set*/, const uint32_t &/*_way*/) override {}
+
+	[[nodiscard]] uint32_t victim(const uint32_t &/*_set*/) override {
+		rng_state ^= rng_state << 13;
+		rng_state ^= rng_state >> 7;
+		rng_state ^= rng_state << 17;
+		return rng_state % assoc;
+	}
+
+	[[nodiscard]] uint32_t getState(const uint32_t &/*_set*/, const uint32_t &/*_way*/) const override {
+		return 0;
+	}
+
+	[[nodiscard]] std::string getName() const override {
+		return "RAND";
+	}
+
+	void saveState(CheckpointWriter &_writer) const override {
+		_writer.write(rng_state);
+	}
+
+	void loadState(CheckpointReader &_reader) override {
+		rng_state = _reader.read<uint64_t>();
+	}
+};
+
+/**
+ * Create a Replacement Policy from its Number
+ * @param _policy Replacement Policy Number (see replacement_t)
+ * @return The created policy, not yet initialized
+ */
+inline std::unique_ptr<ReplacementPolicy> makeReplacementPolicy(const replacement_t &_policy) {
+	switch (_policy) {
+		case replacement_t::repl_lru:
+			return std::make_unique<RecencyListPolicy>(true);
+		case replacement_t::repl_tree_plru:
+			return std::make_unique<TreePLRUPolicy>();
+		case replacement_t::repl_srrip:
+			return std::make_unique<RRIPPolicy>(false);
+		case replacement_t::repl_brrip:
+			return std::make_unique<RRIPPolicy>(true);
+		case replacement_t::repl_random:
+			return std::make_unique<RandomPolicy>();
+		case replacement_t::repl_fifo:
+			return std::make_unique<RecencyListPolicy>(false);
+	}
+	throw std::runtime_error("ERR Replacement Policy Unrecognized");
+}
+
+#endif //CODE_REPLACEMENTPOLICY_H
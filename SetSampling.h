@@ -0,0 +1,132 @@
+#ifndef CODE_SETSAMPLING_H
+#define CODE_SETSAMPLING_H
+
+#include "Include.h"
+
+/* Sampling Methods accepted by sss
+ *
+ * 0: Off (every set simulated), 1: Every Nth set, 2: Hashed, one in N sets chosen by a hash of the set
+ */
+enum class sampling_t {
+	sample_off = 0, sample_every_nth = 1, sample_hashed = 2
+};
+
+/* Set Sampling Shared by All Levels of a System
+ *
+ * Sets are grouped into classes by the lowest index bits common to every level, i.e. the index of the level
+ * with the fewest sets: (address >> offset_bits) mod class_count. Since every level's set count is a power of
+ * two at least class_count, each set of each level belongs to exactly one class, and an access, its fills and
+ * its write-backs all stay in the class of its address. Only accesses to sampled classes are simulated.
+ */
+class SetSampler {
+private:
+	sampling_t method{sampling_t::sample_off};
+	uint32_t ratio{1};
+	uint32_t offset_bits{0};
+	uint32_t class_mask{0};
+	std::vector<uint8_t> sampled_classes;
+
+	/**
+	 * Mix the Bits of a Class Number (murmur3 finalizer) so Hashed Samples Spread over the Index Space
+	 */
+	[[nodiscard]] static uint32_t mixClass(uint32_t _class) {
+		_class ^= _class >> 16;
+		_class *= 0x85EBCA6BU;
+		_class ^= _class >> 13;
+		_class *= 0xC2B2AE35U;
+		_class ^= _class >> 16;
+		return _class;
+	}
+
+public:
+
+	/**
+	 * Choose the Sampling Method
+	 * @param _method Sampling Method (see sampling_t)
+	 * @param _ratio Keep one in _ratio classes
+	 */
+	void setMethod(const sampling_t &_method, const uint32_t &_ratio) {
+		if (_ratio == 0)
+			throw std::invalid_argument("ERR Sampling Ratio Must be Positive");
+		this->method = _method;
+		this->ratio = _ratio;
+	}
+
+	/**
+	 * Choose the Sampled Classes once the Geometry of Every Level is Known
+	 * @param _offset_bits Offset bits shared by every level
+	 * @param _class_count Set count of the level with the fewest sets
+	 */
+	void init(const uint32_t &_offset_bits, const uint32_t &_class_count) {
+		this->offset_bits = _offset_bits;
+		this->class_mask = _class_count - 1;
+		this->sampled_classes.assign(_class_count, 0);
+		for (uint32_t this_class = 0; this_class < _class_count; this_class++)
+			this->sampled_classes[this_class] = this->method == sampling_t::sample_every_nth ?
+												this_class % this->ratio == 0 :
+												mixClass(this_class) % this->ratio == 0;
+		if (std::find(this->sampled_classes.begin(), this->sampled_classes.end(), 1) == this->sampled_classes.end())
+			throw std::invalid_argument("ERR Sampling Ratio Leaves No Set Sampled");
+	}
+
+	[[nodiscard]] bool isEnabled() const {
+		return this->method != sampling_t::sample_off;
+	}
+
+	/**
+	 * Check if an Address Maps to a Sampled Class
+	 */
+	[[nodiscard]] bool isSampled(const address_t &_address) const {
+		return this->sampled_classes[(_address >> this->offset_bits) & this->class_mask] != 0;
+	}
+
+	[[nodiscard]] const std::vector<uint8_t> &getSampledClasses() const {
+		return this->sampled_classes;
+	}
+};
+
+/* Estimate of a Ratio from Set Sampling with its 95% Confidence Interval
+ *
+ * Each sampled class is one cluster of the sample. The ratio estimator r = sum(x) / sum(n) over the sampled
+ * classes has variance (1 - f) * s^2 / (m * nbar^2), s^2 = sum((x_j - r * n_j)^2) / (m - 1), for m sampled
+ * classes out of M, f = m / M and nbar = sum(n) / m.
+ */
+struct SampleEstimate {
+	double ratio{0};
+	double low{0};
+	double high{0};
+	double fraction{1};
+
+	/**
+	 * @param _class_counts [Events Counted][Accesses] of every class; unsampled classes are skipped
+	 * @param _sampled_classes 1 for every sampled class
+	 */
+	SampleEstimate(const std::vector<std::pair<uint64_t, uint64_t>> &_class_counts,
+				   const std::vector<uint8_t> &_sampled_classes) {
+		double counted_sum{0}, access_sum{0}, sample_count{0};
+		for (size_t i = 0; i < _class_counts.size(); i++) {
+			if (_sampled_classes[i] == 0) continue;
+			counted_sum += double(_class_counts[i].first);
+			access_sum += double(_class_counts[i].second);
+			sample_count++;
+		}
+		this->fraction = sample_count / double(_class_counts.size());
+		this->ratio = access_sum == 0 ? 0 : counted_sum / access_sum;
+		this->low = this->high = this->ratio;
+		if (sample_count < 2 || access_sum == 0) return;
+		double residual_sum{0};
+		for (size_t i = 0; i < _class_counts.size(); i++) {
+			if (_sampled_classes[i] == 0) continue;
+			double residual = double(_class_counts[i].first) - this->ratio * double(_class_counts[i].second);
+			residual_sum += residual * residual;
+		}
+		double mean_accesses = access_sum / sample_count;
+		double variance = (1 - this->fraction) * (residual_sum / (sample_count - 1)) /
+						  (sample_count * mean_accesses * mean_accesses);
+		double half_width = 1.96 * std::sqrt(variance);
+		this->low = std::max(0.0, this->ratio - half_width);
+		this->high = std::min(1.0, this->ratio + half_width);
+	}
+};
+
+#endif //CODE_SETSAMPLING_H
@@ -0,0 +1,213 @@
+#ifndef CODE_STACKDISTANCE_H
+#define CODE_STACKDISTANCE_H
+
+#include "Include.h"
+#include "Core.h"
+
+#include <numeric>
+
+/* Growable Fenwick (Binary Indexed) Tree of Counts
+ *
+ * Elements are only ever appended at the end, each append costs O(log n):
+ * node i covers (i - lowbit(i), i], so a new node is the new value plus the sum of the elements it covers.
+ */
+class GrowingFenwickTree {
+private:
+	std::vector<int64_t> nodes{0};//nodes[0] unused, nodes are 1-based
+
+public:
+
+	/**
+	 * Sum of Elements 1 to _position
+	 */
+	[[nodiscard]] int64_t prefix(uint64_t _position) const {
+		int64_t sum{0};
+		for (; _position > 0; _position &= _position - 1)
+			sum += nodes[_position];
+		return sum;
+	}
+
+	/**
+	 * Add to an Existing Element
+	 */
+	void add(uint64_t _position, const int64_t &_delta) {
+		for (; _position < nodes.size(); _position += _position & (~_position + 1))
+			nodes[_position] += _delta;
+	}
+
+	/**
+	 * Append an Element at Position size() + 1
+	 */
+	void append(const int64_t &_value) {
+		uint64_t position = nodes.size();
+		uint64_t covered_from = position - (position & (~position + 1));
+		nodes.push_back(_value + prefix(position - 1) - prefix(covered_from));
+	}
+
+	[[nodiscard]] uint64_t size() const {
+		return nodes.size() - 1;
+	}
+};
+
+/* Mattson Stack Distances of One Set Count
+ *
+ * Blocks map to sets as in Cache (block address mod set count). Each set keeps its own local time and a
+ * Fenwick tree marking the local time of the latest access of every block; the LRU stack distance of an
+ * access is the number of marks after the block's previous access. An A-way LRU cache with this set count
+ * hits exactly the accesses at distance < A.
+ */
+class SetStackDistance {
+private:
+	uint32_t index_bits{0};
+	uint32_t max_assoc{0};
+	std::vector<GrowingFenwickTree> set_trees;
+	std::vector<uint64_t> last_access;//block id -> local time of its latest access, 0 if never accessed
+
+	//distance_counts[d]: accesses at stack distance d < max_assoc
+	std::vector<uint64_t> distance_counts;
+
+public:
+
+	SetStackDistance(const uint32_t &_index_bits, const uint32_t &_max_assoc) {
+		this->index_bits = _index_bits;
+		this->max_assoc = _max_assoc;
+		this->set_trees.resize(size_t{1} << _index_bits);
+		this->distance_counts.assign(_max_assoc, 0);
+	}
+
+	/**
+	 * Record an Access to a Block
+	 * @param _block Address without its offset bits
+	 * @param _block_id Dense number of the block, in order of first reference
+	 */
+	void access(const address_t &_block, const uint32_t &_block_id) {
+		GrowingFenwickTree &set_tree = set_trees[_block & ((address_t{1} << index_bits) - 1)];
+		set_tree.append(1);
+		uint64_t now = set_tree.size();
+		if (_block_id >= last_access.size()) {//first reference, a miss at every size
+			last_access.push_back(now);
+			return;
+		}
+		uint64_t &previous = last_access[_block_id];
+		uint64_t distance = set_tree.prefix(now - 1) - set_tree.prefix(previous);
+		if (distance < max_assoc)
+			distance_counts[distance]++;
+		set_tree.add(previous, -1);
+		previous = now;
+	}
+
+	/**
+	 * Number of Hits of an LRU Cache with this Set Count
+	 * @param _assoc Set Associativity, at most max_assoc
+	 */
+	[[nodiscard]] uint64_t getHits(const uint32_t &_assoc) const {
+		return std::accumulate(distance_counts.begin(), distance_counts.begin() + _assoc, uint64_t{0});
+	}
+};
+
+/* Miss-Ratio Curves of Every LRU Cache Size at One Block Size, in One Pass over a Trace
+ *
+ * Covers every power-of-two set count from 1 (fully associative) to max_sets and every associativity
+ * from 1 to max_assoc. The model is a single Write-Back + Write-Allocate level, where reads and writes both
+ * allocate and update recency, so the numbers match the hit_miss_count of that System exactly.
+ */
+class StackDistance {
+private:
+	uint32_t block_size{0};
+	uint32_t offset_bits{0};
+	uint32_t max_sets{0};
+	uint32_t max_assoc{0};
+	uint64_t access_count{0};
+	std::unordered_map<address_t, uint32_t> block_ids;//block address -> dense id, shared by all set counts
+	std::vector<SetStackDistance> set_counts;//one per power-of-two set count, 1 set first
+
+	/**
+	 * Simulate One Point with a Normal Single-Level WBWA LRU System
+	 * @return Misses counted by the cache
+	 */
+	[[nodiscard]] static uint64_t simulateMisses(const std::vector<Task> &_tasks, const uint32_t &_block_size,
+												 const uint32_t &_set_count, const uint32_t &_assoc) {
+		System system;
+		system.setQuiet(true);
+		const auto &instruction_map = Core::getInstructionMap();
+		std::vector<std::pair<std::string, Core::ArgumentTuple_t>> instructions{
+				{"con", {1, _block_size, 1}},
+				{"scd", {1, _set_count * _assoc * _block_size, _assoc}},
+				{"scl", {1, 1, 0}},
+				{"inc", {1, 0, 0}},
+				{"sml", {1, 0, 0}}};
+		for (auto &this_instruction: instructions)
+			std::invoke(instruction_map.at(this_instruction.first).first, system, &this_instruction.second);
+		system.runSortedTasks(_tasks);
+		return system.getCacheHitMiss(1).second;
+	}
+
+public:
+
+	/**
+	 * @param _block_size Bytes per block, a power of two
+	 * @param _max_sets Largest set count, a power of two
+	 * @param _max_assoc Largest set associativity
+	 */
+	StackDistance(const uint32_t &_block_size, const uint32_t &_max_sets, const uint32_t &_max_assoc) {
+		if (_block_size == 0 || (_block_size & (_block_size - 1)) != 0)
+			throw std::invalid_argument("ERR Block Size is not a Power of Two");
+		if (_max_sets == 0 || (_max_sets & (_max_sets - 1)) != 0)
+			throw std::invalid_argument("ERR Number of Sets is not a Power of Two");
+		if (_max_assoc == 0)
+			throw std::invalid_argument("ERR Set Associativity Must be Positive");
+		this->block_size = _block_size;
+		this->offset_bits = __builtin_ctz(_block_size);
+		this->max_sets = _max_sets;
+		this->max_assoc = _max_assoc;
+		for (uint32_t index_bits = 0; (uint32_t{1} << index_bits) <= _max_sets; index_bits++)
+			this->set_counts.emplace_back(index_bits, _max_assoc);
+	}
+
+	/**
+	 * Feed Every Access of a Sorted Task List
+	 */
+	void run(const std::vector<Task> &_tasks) {
+		for (const Task &this_task: _tasks) {
+			address_t block = this_task.getTaskValue() >> offset_bits;
+			uint32_t block_id = block_ids.emplace(block, block_ids.size()).first->second;
+			for (SetStackDistance &this_set_count: set_counts)
+				this_set_count.access(block, block_id);
+		}
+		access_count += _tasks.size();
+	}
+
+	/**
+	 * Write the Miss-Ratio Curves, One Row per (Set Count, Associativity)
+	 * Columns: SETS, ASSOC, SIZE (bytes, the scd total_size), ACCESSES, MISSES, MISS_RATE, SIMULATED_MISSES
+	 * @param _curve_filename CSV file to be written
+	 * @param _check_tasks If not null, every point is also simulated with a normal System on these tasks,
+	 *                     filling SIMULATED_MISSES
+	 * @return Number of points whose simulated misses differ from the curve (0 if not checked)
+	 */
+	uint64_t printCurves(const std::string &_curve_filename, const std::vector<Task> *_check_tasks) const {
+		std::ofstream curve_writer{_curve_filename, std::ios::trunc};
+		if (!curve_writer.is_open())
+			throw std::runtime_error("ERR Cannot Open Curve File " + _curve_filename);
+		curve_writer << "SETS,ASSOC,SIZE,ACCESSES,MISSES,MISS_RATE,SIMULATED_MISSES" << std::endl;
+		uint64_t mismatch_count{0};
+		for (size_t index_bits = 0; index_bits < set_counts.size(); index_bits++) {
+			uint32_t set_count = uint32_t{1} << index_bits;
+			for (uint32_t assoc = 1; assoc <= max_assoc; assoc++) {
+				uint64_t misses = access_count - set_counts[index_bits].getHits(assoc);
+				curve_writer << set_count << "," << assoc << "," << uint64_t{set_count} * assoc * block_size << ","
+							 << access_count << "," << misses << ","
+							 << (access_count == 0 ? 0.0 : double(misses) / double(access_count)) << ",";
+				if (_check_tasks != nullptr) {
+					uint64_t simulated = simulateMisses(*_check_tasks, block_size, set_count, assoc);
+					mismatch_count += simulated != misses;
+					curve_writer << simulated;
+				}
+				curve_writer << std::endl;
+			}
+		}
+		return mismatch_count;
+	}
+};
+
+#endif //CODE_STACKDISTANCE_H
@@ -0,0 +1,243 @@
+#ifndef CODE_SWEEP_H
+#define CODE_SWEEP_H
+
+#include "Include.h"
+#include "Core.h"
+
+#include <atomic>
+#include <thread>
+
+/* Multi-Configuration Sweep
+ *
+ * A sweep file holds configuration instructions only (con, scd, scl, srp, sml, inc), one block per
+ * configuration, each block ending with ins. Any argument may list several values, $a|b|c, and a block
+ * expands to every combination of them. Tasks in the sweep file are ignored.
+ *
+ * The trace (text instructions or binary .ctr) is read once and its accesses sorted once into a single
+ * shared task list; every configuration gets its own System, run quietly on a pool of worker threads.
+ * Report tasks (pcr/pci), generators and logging are skipped: the result of each configuration is one row of a CSV.
+ */
+class Sweep {
+	using Instruction_t = std::pair<std::string, Core::ArgumentTuple_t>;
+
+	//Expanded Configurations, Each a List of Instructions in File Order
+	std::vector<std::vector<Instruction_t>> configs;
+
+	//Accesses of the Trace in Arrive-Time Order, Shared Read-Only by All Workers
+	std::vector<Task> tasks;
+
+	//Result of One Configuration: [Clock][Hits and Misses per Level][Error, empty on success]
+	struct SweepResult {
+		uint64_t clock_count{0};
+		std::vector<std::pair<uint64_t, uint64_t>> hit_miss_counts;
+		std::string error;
+	};
+
+	/**
+	 * Split a $-Argument into its Values, $a|b|c giving a, b and c
+	 */
+	static std::vector<address_t> argumentToValues(const std::string &_argument) {
+		if (_argument.size() < 2 || _argument.at(0) != '$')
+			throw std::runtime_error("ERR Instruction Argument Format Error");
+		std::vector<address_t> values;
+		std::stringstream value_reader{_argument.substr(1)};
+		std::string this_value;
+		while (std::getline(value_reader, this_value, '|')) {
+			if (this_value.empty() || !std::all_of(this_value.begin(), this_value.end(), ::isdigit))
+				throw std::runtime_error("ERR Instruction Argument Format Error");
+			unsigned long long value = std::stoull(this_value);
+			if (value > ADDRESS_MAX)
+				throw std::out_of_range("ERR Instruction Argument Wider than an Address");
+			values.push_back(address_t(value));
+		}
+		return values;
+	}
+
+	/**
+	 * Expand a Block of Instructions with Value Lists into Every Combination
+	 * The last listed argument varies fastest
+	 * @param _block Instruction names with the values of each argument
+	 */
+	void expandBlock(const std::vector<std::pair<std::string, std::vector<std::vector<address_t>>>> &_block) {
+		std::vector<std::pair<size_t, size_t>> digits;//[instruction][argument] of every argument
+		for (size_t i = 0; i < _block.size(); i++)
+			for (size_t j = 0; j < _block[i].second.size(); j++)
+				digits.emplace_back(i, j);
+		std::vector<size_t> choice(digits.size(), 0);
+		while (true) {
+			std::vector<Instruction_t> this_config;
+			size_t digit{0};
+			for (const auto &this_instruction: _block) {
+				Core::ArgumentTuple_t arguments{0, 0, 0};
+				for (size_t j = 0; j < this_instruction.second.size(); j++, digit++) {
+					address_t value = this_instruction.second[j][choice[digit]];
+					if (j == 0) std::get<0>(arguments) = value;
+					else if (j == 1) std::get<1>(arguments) = value;
+					else if (j == 2) std::get<2>(arguments) = value;
+				}
+				this_config.emplace_back(this_instruction.first, arguments);
+			}
+			configs.push_back(std::move(this_config));
+			size_t position = digits.size();
+			while (position > 0) {//advance the combination like an odometer
+				position--;
+				const auto &values = _block[digits[position].first].second[digits[position].second];
+				if (++choice[position] < values.size()) break;
+				choice[position] = 0;
+				if (position == 0) return;
+			}
+			if (digits.empty()) return;
+		}
+	}
+
+	/**
+	 * Read the Sweep File and Expand Every Block
+	 */
+	void loadConfigs(const std::string &_sweep_filename) {
+		std::ifstream sweep_reader{_sweep_filename};
+		if (!sweep_reader.is_open())
+			throw std::runtime_error("ERR Sweep File NOT Found.");
+		const auto &instruction_map = Core::getInstructionMap();
+		std::vector<std::pair<std::string, std::vector<std::vector<address_t>>>> this_block;
+		std::string this_word;
+		while (sweep_reader >> this_word) {
+			if (this_word == "hat") break;
+			auto this_function = instruction_map.find(this_word);
+			if (this_function == instruction_map.end()) continue;//comments, as in instruction files
+			if (this_word == "ins") {
+				this->expandBlock(this_block);
+				this_block.clear();
+				continue;
+			}
+			std::vector<std::vector<address_t>> arguments;
+			for (size_t i = 0; i < this_function->second.second; i++) {
+				std::string this_argument;
+				if (!(sweep_reader >> this_argument))
+					throw std::runtime_error("ERR Sweep File Ends inside an Instruction");
+				arguments.push_back(argumentToValues(this_argument));
+			}
+			if (this_word == "tre" || this_word == "twr" || this_word == "tcr" || this_word == "tcw" ||
+				this_word == "pcr" || this_word == "pci" || this_word == "pcc" || this_word == "pcs" ||
+				this_word == "plh" || this_word == "sck" || this_word == "lgv" || this_word == "sis" ||
+				this_word == "sim" || this_word == "sce" || this_word == "stm" ||
+				this_word == "par" || this_word == "gcf" || this_word == "gsq" || this_word == "gru" ||
+				this_word == "gzf" || this_word == "gpc" || this_word == "gpt")
+				continue;//the trace supplies the tasks; sweeps never log, stream or shard
+			this_block.emplace_back(this_word, std::move(arguments));
+		}
+		if (!this_block.empty())
+			throw std::runtime_error("ERR Sweep Block Missing ins");
+	}
+
+	/**
+	 * Build, Configure and Run the System of One Configuration
+	 */
+	SweepResult runConfig(const std::vector<Instruction_t> &_config) const {
+		SweepResult result;
+		try {
+			System system;
+			system.setQuiet(true);
+			for (const Instruction_t &this_instruction: _config) {
+				Core::ArgumentTuple_t arguments = this_instruction.second;
+				std::invoke(Core::getInstructionMap().at(this_instruction.first).first, system, &arguments);
+			}
+			system.runSortedTasks(this->tasks);
+			result.clock_count = system.getClockCount();
+			for (uint32_t level = 1; level <= system.getCacheCount(); level++)
+				result.hit_miss_counts.push_back(system.getCacheHitMiss(level));
+		} catch (std::exception &_exep) {
+			result.error = _exep.what();
+		}
+		return result;
+	}
+
+	/**
+	 * Describe a Configuration as its Instructions, Separated by Semicolons
+	 */
+	static std::string describeConfig(const std::vector<Instruction_t> &_config) {
+		std::string description;
+		for (const Instruction_t &this_instruction: _config) {
+			if (!description.empty()) description += "; ";
+			description += this_instruction.first;
+			size_t argument_count = Core::getInstructionMap().at(this_instruction.first).second;
+			address_t arguments[3]{std::get<0>(this_instruction.second), std::get<1>(this_instruction.second),
+								  std::get<2>(this_instruction.second)};
+			for (size_t i = 0; i < argument_count; i++)
+				description += " $" + std::to_string(arguments[i]);
+		}
+		return description;
+	}
+
+public:
+
+	/**
+	 * Load a Sweep File and a Trace
+	 * @param _sweep_filename Configuration blocks, see above
+	 * @param _trace_filename Text instruction file or binary trace supplying the accesses
+	 */
+	Sweep(const std::string &_sweep_filename, const std::string &_trace_filename) {
+		this->loadConfigs(_sweep_filename);
+		this->tasks = loadSortedAccesses(_trace_filename);
+	}
+
+	/**
+	 * Run Every Configuration and Write One Row per Configuration
+	 * Columns: CONFIG, CLOCK, then HITS, MISSES and MISS_RATE of each level, then ERROR and DESCRIPTION
+	 * @param _results_filename CSV file to be written
+	 * @param _thread_count Number of worker threads, 0 for one per hardware thread
+	 * @return Number of configurations run
+	 */
+	size_t run(const std::string &_results_filename, size_t _thread_count) {
+		if (_thread_count == 0)
+			_thread_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+		_thread_count = std::max<size_t>(1, std::min(_thread_count, this->configs.size()));
+		std::vector<SweepResult> results(this->configs.size());
+		std::atomic<size_t> next_config{0};
+		auto worker = [this, &results, &next_config]() {
+			for (size_t i = next_config++; i < this->configs.size(); i = next_config++)
+				results[i] = this->runConfig(this->configs[i]);
+		};
+		std::vector<std::thread> workers;
+		for (size_t i = 0; i < _thread_count; i++)
+			workers.emplace_back(worker);
+		for (std::thread &this_worker: workers)
+			this_worker.join();
+
+		size_t level_count{0};
+		for (const SweepResult &this_result: results)
+			level_count = std::max(level_count, this_result.hit_miss_counts.size());
+		std::ofstream results_writer{_results_filename, std::ios::trunc};
+		if (!results_writer.is_open())
+			throw std::runtime_error("ERR Cannot Open Results File " + _results_filename);
+		results_writer << "CONFIG,CLOCK";
+		for (size_t level = 1; level <= level_count; level++)
+			results_writer << ",L" << level << "_HITS,L" << level << "_MISSES,L" << level << "_MISS_RATE";
+		results_writer << ",ERROR,DESCRIPTION" << std::endl;
+		for (size_t i = 0; i < results.size(); i++) {
+			const SweepResult &this_result = results[i];
+			results_writer << i << "," << this_result.clock_count;
+			for (size_t level = 0; level < level_count; level++) {
+				if (level >= this_result.hit_miss_counts.size()) {
+					results_writer << ",,,";
+					continue;
+				}
+				uint64_t hits = this_result.hit_miss_counts[level].first;
+				uint64_t misses = this_result.hit_miss_counts[level].second;
+				results_writer << "," << hits << "," << misses << ","
+							   << (hits + misses == 0 ? 0.0 : double(misses) / double(hits + misses));
+			}
+			results_writer << "," << this_result.error << "," << describeConfig(this->configs[i]) << std::endl;
+		}
+		return results.size();
+	}
+
+	[[nodiscard]] size_t getConfigCount() const {
+		return this->configs.size();
+	}
+
+	[[nodiscard]] size_t getTaskCount() const {
+		return this->tasks.size();
+	}
+};
+
+#endif //CODE_SWEEP_H
@@ -5,6 +5,12 @@
 
 #include "Cache.h"
 #include "Task.h"
+#include "TraceFile.h"
+#include "EventLog.h"
+#include "Generator.h"
+#include "IntervalStats.h"
+
+#include <thread>
 
 class System {
 
@@ -25,43 +31,684 @@ private:
 	//#2: Number of Bytes each DataBlock should hold (Each cache has a copy of this)
 	uint32_t block_size{0};
 
-	//#3: Pointer of Top Cache (Second-top layer cache\memory has a copy of this)
-	std::unique_ptr<Cache> top_cache_ptr;
+	/* #3: Every Cache of the System in One Contiguous Array, and the Levels each Core Walks through
+	 *
+	 * caches holds the private levels of core 0, core 1, ... followed by the shared levels.
+	 * core_paths[core * cache_count + level - 1] points at the cache of that level as seen by that core.
+	 * Both are rebuilt only by con and cor, before any cache is configured.
+	 */
+	std::vector<Cache> caches;
+	std::vector<Cache *> core_paths;
 
 	//#4: Total Clock Cycles Needed to Complete (Each cache has a copy of this)
 	uint64_t memory_latency{0};//#4
 
-	/* #5 Pointer of File Writer
+	/* #5 Event Log of Every Access, log_system.lgs (text) or log_system.lgb (binary)
 	 *
-	 * use (*global_writer_ptr).operator<<() to write
-	 * e.g. (*global_writer_ptr)<<("THINGS TO WRITE")<<std::endl;
+	 * Level and format set by lgv; the file is opened when the system starts running
 	 */
-	std::pair<std::ofstream, uint32_t> report_writer;
+	EventLog event_log;
 
 	/* #6 Container holding tasks need to be done
 	 * Ready if Sorted.
 	 */
 	std::vector<Task> task_queue;
 
+	/* #7 Streaming Mode, Enabled by stm
+	 * Tasks run as soon as they are scheduled instead of being kept until ins. They pass through a
+	 * reorder window holding at most stream_window tasks, so traces that are only locally out of order
+	 * still run in arrive-time order, while memory stays bounded by the window size.
+	 */
+	bool streaming{false};
+	size_t stream_window{0};
+	std::vector<Task> stream_heap;//min-heap on Task order, at most stream_window + 1 tasks
+	std::unique_ptr<Task> last_streamed_task{nullptr};
+
+	/* #8 Set Sampling, Enabled by sss
+	 * Only accesses mapping to the sampled sets are simulated; hit/miss reports add confidence intervals
+	 */
+	SetSampler set_sampler;
+
+	//#9 Echo of Every Instruction, Discarded in Quiet Mode (Sweeps run many Systems at once)
+	bool quiet{false};
+	std::ostream null_stream{nullptr};
+
+	/* #10 Cores, Set by cor
+	 * Levels 1 to private_levels are private to each core, the rest are shared: every core's path holds its own
+	 * private levels, then the same shared levels. Private levels of different cores are kept coherent with
+	 * MESI by snooping: Modified is a dirty copy, Exclusive a clean copy no other core holds, Shared a clean
+	 * copy other cores also hold, Invalid no copy.
+	 */
+	size_t core_count{1};
+	uint32_t private_levels{0};
+	uint64_t snoop_latency{0};
+	uint16_t current_core{0};
+
+	//Coherence Traffic of a Core, Reported by pcc
+	struct CoherenceCount {
+		uint64_t reads{0};
+		uint64_t writes{0};
+		uint64_t invalidations_sent{0};
+		uint64_t invalidations_received{0};
+		uint64_t interventions{0};//dirty copies written back because another core asked for them
+		uint64_t snoop_cycles{0};
+	};
+	std::vector<CoherenceCount> coherence_counts{1};
+
+	/* #11 Parallel Mode, Enabled by par
+	 * The task queue is run by up to parallel_threads shards, each a System with the same configuration that only
+	 * sees the accesses of its own sets. configuration records every configuration instruction so shards can replay it.
+	 */
+	size_t parallel_threads{0};
+	std::vector<std::pair<bool (System::*)(std::tuple<address_t, address_t, address_t> *),
+			std::tuple<address_t, address_t, address_t>>> configuration;
+
+	/* #12 Synthetic Access Streams, Configured by gcf and Produced by gsq/gru/gzf/gpc/gpt
+	 * Generated accesses arrive one per clock cycle after the latest task scheduled so far
+	 */
+	AccessGenerator access_generator;
+	uint64_t latest_arrive_time{0};
+
+	/* #13 Prefetchers, Set per Level by spf
+	 * Prefetches are fetched in the background: they never hold up the demand that triggered them, which only
+	 * times when their data arrives. Their fetch latency is what a read would take from the level below on, but
+	 * only the prefetching level is filled, and the levels below are neither counted nor changed.
+	 */
+	bool prefetching{false};
+	std::vector<address_t> prefetch_targets;
+
+	/* #14 Non-Blocking Caches, Enabled by mhr
+	 * Accesses issue at their arrive time instead of waiting for the previous one to complete, and the clock
+	 * keeps the latest completion. A read miss holds a register of its level until the fill returns; cache
+	 * state still changes in issue order, so a later access hitting a block whose fill is outstanding merges
+	 * into it. Levels without an mhr block (one register). Writes retire into a write buffer and hold none.
+	 */
+	bool non_blocking{false};
+
+	/* #15 Inclusion Policy between the Levels of a Core's Path, Chosen by sip, and Victim Caches Attached by svc
+	 * Inclusive: a block evicted from a level is invalidated in every level above it (every core's copies for a
+	 * shared level), and a write allocating a block installs it in the levels below too, in the background.
+	 * Exclusive: a block lives in one level of a path: reads fill the top level only, taking the block out of the
+	 * level that held it, and every block evicted from a level, clean or dirty, is swapped into the level below.
+	 */
+	inclusion_t inclusion{inclusion_t::inclusion_nine};
+	bool victim_caching{false};
+
+	/* #16 Checkpoints, Saved by sck Tasks and Restored by lck
+	 * A checkpoint holds every cache (tags, valid/dirty bits, replacement, prefetcher, MSHR and victim cache state
+	 * and counters), the clock, the coherence counters and latency histograms. lck restores one right before the
+	 * first task runs, so runs branching from the same warmup only simulate the accesses after it.
+	 */
+	std::string restore_filename;
+	bool checkpointing{false};
+
+	/* #17 Functional Fast-Forward, Set by ffw
+	 * Until forward_accesses accesses have run or a task arrives at forward_time (0 for no such bound), accesses
+	 * only update cache contents and replacement state: their clock cycles are dropped, the event log is not opened
+	 * yet and report tasks are dropped. The detailed run then starts with every counter cleared.
+	 */
+	bool fast_forwarding{false};
+	uint64_t forward_accesses{0};
+	uint64_t forward_time{0};
+	uint64_t forwarded_accesses{0};
+
+	/* #18 Interval Statistics, Set by sis
+	 * Every level's hits, misses, evictions and write-backs, and the accesses and their latency, are appended to one
+	 * file per interval of accesses or clock cycles of the detailed run. level_counts is the scratch they are
+	 * sampled into; with cycle intervals, access_start_counts holds them from before the access running, for the
+	 * boundaries it passes.
+	 */
+	IntervalStats interval_stats;
+	std::vector<LevelCount> level_counts;
+	std::vector<LevelCount> access_start_counts;
+
+	/* #19 Delta Images, Enabled by sim
+	 * pci then writes only the sets of the level changed since its previous image (dlt_l<id>_<time>.csv), and
+	 * Cache::rebuildImage turns a chain of them back into the full image at any of their arrive times
+	 */
+	bool delta_images{false};
+
+	/* #20 Completion Latency of Every Access of a Core, Reported by plh
+	 * Bucket 0 counts accesses taking 0 clock cycles, bucket b > 0 those taking 2^(b-1) to 2^b - 1. With sce, every
+	 * level's counters and every core's histogram are also written when the run ends.
+	 */
+	static constexpr size_t LATENCY_BUCKETS = 65;
+	std::vector<std::array<uint64_t, LATENCY_BUCKETS>> latency_histograms{1};
+	bool export_counts{false};
+
 	// Status of Initialization. All Members MUST be true before System Initialization
 	std::array<bool, 7> ready{false, false, false, false, false, false, false};
 
+	//Scratch of readWalk: the decoded address of every level it missed, filled on the way back up
+	std::vector<DecodedAddress> walk_decoded;
+
+	//Scratch of readWalk: the register every level that missed holds, released on the way back up
+	std::vector<size_t> walk_mshrs;
+
+	//Scratch of writeWalk: statuses of the levels a write passed through, returned once it stops
+	std::vector<status_t> walk_statuses;
+
+	/**
+	 * Narrow an Instruction Argument to the Width it is Kept at
+	 * Arguments are as wide as addresses, so only 64-bit builds can hold values that do not fit
+	 * @throw std::out_of_range if the argument does not fit, as Core throws for arguments wider than an address
+	 */
+	template<typename T>
+	[[nodiscard]] static T narrowArgument(const address_t &_argument) {
+		if constexpr (sizeof(T) < sizeof(address_t))
+			if (_argument > std::numeric_limits<T>::max())
+				throw std::out_of_range("ERR Instruction Argument Out of Range");
+		return static_cast<T>(_argument);
+	}
+
+	/**
+	 * Create the Caches of Every Core and Lay Out the Path of Levels each Core Walks through
+	 * Each cache is given its level, its core (private levels of a multi-core system only) and its parent
+	 */
+	void buildHierarchy() {
+		const size_t private_count = this->core_count * this->private_levels;
+		this->caches.clear();
+		this->caches.resize(private_count + this->cache_count - this->private_levels);
+		this->core_paths.assign(this->core_count * this->cache_count, nullptr);
+		for (uint16_t core = 0; core < this->core_count; core++)
+			for (uint32_t level = 1; level <= this->cache_count; level++)
+				this->core_paths[core * this->cache_count + level - 1] = level <= this->private_levels ?
+						&this->caches[core * this->private_levels + level - 1] :
+						&this->caches[private_count + level - this->private_levels - 1];
+		for (uint16_t core = 0; core < this->core_count; core++) {
+			Cache *const *path = &this->core_paths[core * this->cache_count];
+			for (uint32_t level = 1; level <= this->cache_count; level++) {
+				path[level - 1]->setId(level);
+				if (level <= this->private_levels && this->core_count > 1)
+					path[level - 1]->setCore(core);
+				path[level - 1]->linkParent(level < this->cache_count ? path[level] : nullptr);
+			}
+		}
+		this->walk_decoded.resize(this->cache_count);
+		this->walk_mshrs.resize(this->cache_count);
+	}
+
 	/**
 	 * Retrieve the Pointer of Cache of Specific Level
 	 * @param _cache_level Cache Level of Cache Wanted (Top Cache being 1)
-	 * @return The Retrieved Pointer of Cache
+	 * @return The Retrieved Pointer of Cache (of core 0 for a private level)
 	 */
 	[[nodiscard]] Cache *getCacheAtPtr(const uint32_t &_cache_level) {
-		size_t _cache_index = _cache_level - 1;
-		if (_cache_index > this->cache_count)
+		if (_cache_level < 1 || _cache_level > this->cache_count)
 			throw std::out_of_range("ERR Cache Level Out-of-range");
-		if (top_cache_ptr == nullptr)
-			throw std::runtime_error("ERR Top Cache Ptr is Null");
-		Cache *this_cache_ptr = top_cache_ptr.get();
-		for (size_t i = 0; i < _cache_index; i++) {
-			this_cache_ptr = this_cache_ptr->getParentPtr();
+		if (this->core_paths.empty())
+			throw std::runtime_error("ERR Caches Not Created");
+		return this->core_paths[_cache_level - 1];
+	}
+
+	/**
+	 * Retrieve the Levels a Core Walks through, Top Cache First
+	 * @param _core_id Core, 0 to core_count - 1
+	 * @return Array of cache_count Cache Pointers
+	 */
+	[[nodiscard]] Cache *const *getCorePath(const uint16_t &_core_id) const {
+		if (_core_id >= this->core_count)
+			throw std::out_of_range("ERR Core ID Out-of-range");
+		return &this->core_paths[_core_id * this->cache_count];
+	}
+
+	/**
+	 * Retrieve Every Copy of a Cache Level: One per Core for a Private Level, Only One for a Shared Level
+	 * @param _cache_level Cache Level of Cache Wanted (Top Cache being 1)
+	 */
+	[[nodiscard]] std::vector<Cache *> getCacheCopies(const uint32_t &_cache_level) {
+		if (_cache_level < 1 || _cache_level > this->private_levels)
+			return {this->getCacheAtPtr(_cache_level)};
+		std::vector<Cache *> copies;
+		for (uint16_t core = 0; core < this->core_count; core++)
+			copies.push_back(this->getCorePath(core)[_cache_level - 1]);
+		return copies;
+	}
+
+	/**
+	 * Snoop One Cache and its Victim Cache for a Block (see Cache::snoopTag)
+	 * @return [If Either held the Block][If Either held it Dirty]
+	 */
+	static std::pair<bool, bool> snoopLevel(Cache *const _cache, const address_t &_address, const bool &_invalidate) {
+		auto present_dirty = _cache->snoopTag(_cache->addressDecode(_address), _invalidate);
+		if (_cache->getVictimCache().isEnabled()) {
+			auto buffered = _cache->getVictimCache().snoop(_address, _invalidate);
+			present_dirty.first |= buffered.first;
+			present_dirty.second |= buffered.second;
+		}
+		return present_dirty;
+	}
+
+	/**
+	 * Snoop the Private Levels of Every Other Core for a Block
+	 * Dirty copies, victim caches included, are written back to the first shared level (an intervention); with
+	 * _invalidate every copy is also dropped. The snoop costs snoop_latency once if it found anything to act on.
+	 * @param _address Raw address of the block
+	 * @param _clock_when_called Clock when the snoop starts
+	 * @param _invalidate True for writes (to Modified), false for read misses (to Shared)
+	 * @return Clock when the snoop completes
+	 */
+	[[nodiscard]] uint64_t snoopOtherCores(const address_t &_address, const uint64_t &_clock_when_called,
+										   const bool &_invalidate) {
+		uint64_t elapsed_clock{_clock_when_called};
+		bool any_traffic{false};
+		for (uint16_t core = 0; core < this->core_count; core++) {
+			if (core == this->current_core) continue;
+			bool any_present{false}, any_dirty{false};
+			Cache *const *path = this->getCorePath(core);
+			for (uint32_t level = 0; level < this->private_levels; level++) {
+				auto present_dirty = snoopLevel(path[level], _address, _invalidate);
+				any_present |= present_dirty.first;
+				any_dirty |= present_dirty.second;
+			}
+			if (any_dirty) {//written back into the first shared level (or memory), which every path shares
+				this->coherence_counts[core].interventions++;
+				elapsed_clock = this->writeWalk(path, this->private_levels, _address, elapsed_clock);
+			}
+			if (any_present && _invalidate) {
+				this->coherence_counts[core].invalidations_received++;
+				this->coherence_counts[this->current_core].invalidations_sent++;
+			}
+			any_traffic |= any_dirty || (any_present && _invalidate);
+		}
+		if (any_traffic) {
+			elapsed_clock += this->snoop_latency;
+			this->coherence_counts[this->current_core].snoop_cycles += this->snoop_latency;
+		}
+		return elapsed_clock;
+	}
+
+	/**
+	 * Report the Coherence Traffic of a Core to File
+	 */
+	void printCoherence(const uint16_t &_core_id, const uint64_t &_arrive_time) {
+		const CoherenceCount &counts = this->coherence_counts.at(_core_id);
+		std::ofstream coherence_writer{"coh_c" + std::to_string(_core_id) + "_" + std::to_string(_arrive_time) + ".csv"};
+		coherence_writer << "READS,WRITES,INVALIDATIONS_SENT,INVALIDATIONS_RECEIVED,INTERVENTIONS,SNOOP_CYCLES"
+						 << std::endl;
+		coherence_writer << counts.reads << "," << counts.writes << "," << counts.invalidations_sent << ","
+						 << counts.invalidations_received << "," << counts.interventions << ","
+						 << counts.snoop_cycles << std::endl;
+	}
+
+	/**
+	 * Bucket of the Latency Histograms an Access Taking _latency Clock Cycles Falls in
+	 */
+	[[nodiscard]] static size_t latencyBucket(const uint64_t &_latency) {
+		return _latency == 0 ? 0 : 64 - __builtin_clzll(_latency);
+	}
+
+	/**
+	 * Append the Rows of a Core's Latency Histogram, up to its Highest Bucket Holding an Access
+	 * @param _line Rows of [LOW][HIGH][ACCESSES] are appended, each after _prefix
+	 */
+	void appendLatencyRows(std::string &_line, const uint16_t &_core_id, const std::string &_prefix) const {
+		const std::array<uint64_t, LATENCY_BUCKETS> &histogram = this->latency_histograms.at(_core_id);
+		size_t bucket_end = LATENCY_BUCKETS;
+		while (bucket_end > 0 && histogram[bucket_end - 1] == 0)
+			bucket_end--;
+		for (size_t bucket = 0; bucket < bucket_end; bucket++) {
+			uint64_t low = bucket == 0 ? 0 : uint64_t{1} << (bucket - 1);
+			uint64_t high = bucket == 0 ? 0 : low + (low - 1);
+			_line += _prefix + std::to_string(low) + "," + std::to_string(high) + "," +
+					 std::to_string(histogram[bucket]) + "\n";
+		}
+	}
+
+	/**
+	 * Report the Latency Histogram of a Core to File
+	 */
+	void printLatency(const uint16_t &_core_id, const uint64_t &_arrive_time) const {
+		std::ofstream latency_writer{"lat_c" + std::to_string(_core_id) + "_" + std::to_string(_arrive_time) + ".csv"};
+		std::string lines{"LOW,HIGH,ACCESSES\n"};
+		this->appendLatencyRows(lines, _core_id, "");
+		latency_writer.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+	}
+
+	/**
+	 * Write the Counters of Every Cache (cnt_system.csv) and the Latency Histogram of Every Core (lat_system.csv)
+	 * The CORE column is empty for shared levels
+	 */
+	void exportCounts() {
+		std::ofstream count_writer{"cnt_system.csv"};
+		std::string lines = std::string{"LEVEL,CORE,"} + Cache::countTitles() + "\n";
+		for (uint32_t level = 1; level <= this->cache_count; level++) {
+			std::vector<Cache *> copies = this->getCacheCopies(level);
+			for (size_t copy = 0; copy < copies.size(); copy++) {
+				lines += std::to_string(level) + ",";
+				if (level <= this->private_levels)
+					lines += std::to_string(copy);
+				lines += ",";
+				copies[copy]->appendCounts(lines);
+				lines += "\n";
+			}
+		}
+		count_writer.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+		std::ofstream latency_writer{"lat_system.csv"};
+		lines = "CORE,LOW,HIGH,ACCESSES\n";
+		for (uint16_t core = 0; core < this->core_count; core++)
+			this->appendLatencyRows(lines, core, std::to_string(core) + ",");
+		latency_writer.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+	}
+
+	/**
+	 * Name of the File of a Checkpoint
+	 */
+	[[nodiscard]] static std::string checkpointName(const address_t &_checkpoint_id) {
+		return "ckp_" + std::to_string(_checkpoint_id) + ".ckp";
+	}
+
+	/**
+	 * Write the State of Every Cache, the Clock, the Coherence Counters and Latency Histograms to a Checkpoint File
+	 * @param _checkpoint_id Names the file, ckp_[id].ckp
+	 */
+	void saveCheckpoint(const address_t &_checkpoint_id) {
+		CheckpointWriter writer{checkpointName(_checkpoint_id)};
+		writer.write(this->clock_count);
+		writer.write(uint64_t{this->cache_count});
+		writer.write(uint64_t{this->core_count});
+		writer.write(this->private_levels);
+		writer.write(uint8_t{this->read_write_policy});
+		writer.write(uint32_t(this->inclusion));
+		writer.writeVector(this->coherence_counts);
+		writer.writeVector(this->latency_histograms);
+		for (const Cache &this_cache: this->caches)
+			this_cache.saveState(writer);
+		writer.close();
+	}
+
+	/**
+	 * Replace the State of Every Cache, the Clock, the Coherence Counters and Latency Histograms with a Checkpoint
+	 * Warning: Only call once every cache is initialized and configured, as the checkpoint must match them
+	 */
+	void restoreCheckpoint(const std::string &_filename) {
+		CheckpointReader reader{_filename};
+		this->clock_count = reader.read<uint64_t>();
+		reader.expect(uint64_t{this->cache_count});
+		reader.expect(uint64_t{this->core_count});
+		reader.expect(this->private_levels);
+		reader.expect(uint8_t{this->read_write_policy});
+		reader.expect(uint32_t(this->inclusion));
+		reader.readArray(this->coherence_counts.data(), this->coherence_counts.size());
+		reader.readArray(this->latency_histograms.data(), this->latency_histograms.size());
+		for (Cache &this_cache: this->caches)
+			this_cache.loadState(reader);
+		reader.finish();
+	}
+
+	/**
+	 * Stream the Instruction Echo is Written to
+	 */
+	[[nodiscard]] std::ostream &echo() {
+		return this->quiet ? this->null_stream : std::cout;
+	}
+
+	/**
+	 * Open the Event Log and Choose the Sampled Sets once All Caches are Configured, Right before the First Task Runs
+	 */
+	void startRun() {
+		uint32_t class_count{UINT32_MAX};
+		for (uint32_t level = 1; level <= this->cache_count; level++)
+			class_count = std::min(class_count, this->getCacheAtPtr(level)->getSetCount());
+		if (set_sampler.isEnabled()) {//sample by the index bits every level shares
+			set_sampler.init(this->getCacheAtPtr(1)->getDecoder().getOffsetBits(), class_count);
+			for (uint32_t level = 1; level <= this->cache_count; level++)
+				for (Cache *this_cache: this->getCacheCopies(level))
+					this_cache->enableSampling(set_sampler);
+		}
+		if (this->non_blocking)
+			for (Cache &this_cache: this->caches)
+				if (!this_cache.getMshrFile().isEnabled())
+					this_cache.getMshrFile().configure(1);
+		if (this->inclusion == inclusion_t::inclusion_inclusive)
+			for (Cache &this_cache: this->caches)
+				this_cache.reportBackInvalidations();
+		if (this->delta_images)
+			for (Cache &this_cache: this->caches)
+				this_cache.enableDeltaImages();
+		if (!this->restore_filename.empty())
+			this->restoreCheckpoint(this->restore_filename);
+		if (!this->fast_forwarding)
+			this->openOutputs();
+	}
+
+	/**
+	 * Open the Event Log with the Address Decoder of Every Level, and the Interval Stats
+	 */
+	void openOutputs() {
+		std::vector<AddressDecoder> decoders;
+		for (uint32_t level = 1; level <= this->cache_count; level++)
+			decoders.push_back(this->getCacheAtPtr(level)->getDecoder());
+		event_log.open(decoders);
+		this->sampleLevelCounts(this->level_counts);
+		interval_stats.open(this->level_counts, clock_count);
+	}
+
+	/**
+	 * Sample the Cumulative Counters of Every Level (Summed over the Cores of a Private Level) for the Interval Stats
+	 * @param _counts Filled with the counters of every level, L1 first
+	 */
+	void sampleLevelCounts(std::vector<LevelCount> &_counts) const {
+		_counts.assign(this->cache_count, LevelCount{});
+		for (const Cache &this_cache: this->caches) {
+			LevelCount &this_count = _counts[this_cache.getId() - 1];
+			this_count.hits += this_cache.getHitMissCount().first;
+			this_count.misses += this_cache.getHitMissCount().second;
+			this_count.evictions += this_cache.getCounts().clean_evictions + this_cache.getCounts().dirty_evictions;
+			this_count.writebacks += this_cache.getCounts().writebacks;
+		}
+	}
+
+	/**
+	 * End the Functional Fast-Forward: Clear Every Counter and Open the Event Log and Interval Stats for the Detailed Run
+	 */
+	void finishFastForward() {
+		this->fast_forwarding = false;
+		for (Cache &this_cache: this->caches)
+			this_cache.resetCounts();
+		std::fill(this->coherence_counts.begin(), this->coherence_counts.end(), CoherenceCount{});
+		std::fill(this->latency_histograms.begin(), this->latency_histograms.end(),
+				  std::array<uint64_t, LATENCY_BUCKETS>{});
+		this->openOutputs();
+	}
+
+	/**
+	 * Run an Access of the Functional Fast-Forward, Keeping Only the Cache Contents and Replacement State it Leaves
+	 */
+	void forwardAccess(const Task &_task) {
+		this->current_core = _task.getCoreId();
+		Cache *const *core_path = this->getCorePath(this->current_core);
+		if (_task.getTaskType() == task_t::task_readAddress) {
+			this->forwardRead(core_path, _task.getTaskValue());
+			return;
+		}
+		if (this->core_count > 1)
+			this->forwardSnoop(_task.getTaskValue(), true);
+		this->forwardWrite(core_path, 0, _task.getTaskValue());
+	}
+
+	/**
+	 * Write the Hit and Miss Summary of Every Level (Summed over the Cores of a Private Level), the Last Interval and,
+	 * with sce, Every Counter and Latency Histogram, and Close the Event Log and Interval Stats
+	 */
+	void finishRun() {
+		for (uint32_t level = 1; level <= this->cache_count; level++) {
+			auto hit_miss_count = this->getCacheHitMiss(level);
+			event_log.summary(level, hit_miss_count.first, hit_miss_count.second);
+		}
+		event_log.close();
+		this->sampleLevelCounts(this->level_counts);
+		interval_stats.finish(this->level_counts, clock_count);
+		if (this->export_counts)
+			this->exportCounts();
+	}
+
+	/**
+	 * Order for std::push_heap/std::pop_heap so the Earliest Task is on Top
+	 */
+	static bool laterTask(const Task &_task_a, const Task &_task_b) {
+		return _task_b < _task_a;
+	}
+
+	/**
+	 * Schedule a Task: Queue it until ins, or in Streaming Mode Pass it through the Reorder Window
+	 * @param _task Task to be scheduled
+	 */
+	void scheduleTask(const Task &_task) {
+		this->latest_arrive_time = std::max(this->latest_arrive_time, _task.getArriveTime());
+		if (!this->streaming) {
+			this->task_queue.push_back(_task);
+			return;
+		}
+		this->stream_heap.push_back(_task);
+		std::push_heap(this->stream_heap.begin(), this->stream_heap.end(), laterTask);
+		if (this->stream_heap.size() > this->stream_window)
+			this->runStreamedTask();
+	}
+
+	/**
+	 * Run the Earliest Task of the Reorder Window
+	 * Throws if it arrives earlier than a task already run, meaning the trace is more out of order than the window
+	 * Tasks sharing an arrive time that leave the window separately run in the order they left it
+	 */
+	void runStreamedTask() {
+		std::pop_heap(this->stream_heap.begin(), this->stream_heap.end(), laterTask);
+		const Task this_task = this->stream_heap.back();
+		this->stream_heap.pop_back();
+		if (this->last_streamed_task == nullptr) {
+			if (std::find(this->ready.begin(), this->ready.begin() + 6, false) != this->ready.begin() + 6)
+				throw std::runtime_error("ERR Cannot Stream Task - System Not Ready");
+			this->startRun();
+			this->last_streamed_task = std::make_unique<Task>(this_task);
+		} else if (this_task.getArriveTime() < this->last_streamed_task->getArriveTime())
+			throw std::runtime_error("ERR Task Arrived Outside Streaming Window");
+		*this->last_streamed_task = this_task;
+		clock_count = std::max(clock_count, this_task.getArriveTime());//jump to the next event
+		this->runTask(this_task);
+	}
+
+	/**
+	 * Run the Sorted Task Queue on Shards of Sets, One Thread per Shard
+	 * Sets are grouped into classes by the index bits every level shares (as set sampling does), and class c
+	 * belongs to shard c mod shard_count. An access, its fills, its write-backs and its coherence snoops all
+	 * stay in the sets of its class, so each shard simulates its accesses exactly as the whole system would.
+	 *
+	 * Timing is reconstructed exactly: how long an access takes depends only on the cache state, never on the
+	 * clock, so each shard records the service time of its accesses and the clock is then replayed in task order,
+	 * clock = max(clock, arrive_time) + service_time. Reports split the queue into segments; shards run each
+	 * segment in parallel, then their counts are merged into this System's caches before the report runs.
+	 * Warning: Random replacement and BRRIP draw from per-shard state, so their victims differ from a serial run
+	 */
+	void runTaskQueueParallel() {
+		uint32_t class_count{UINT32_MAX};
+		for (uint32_t level = 1; level <= this->cache_count; level++)
+			class_count = std::min(class_count, this->getCacheAtPtr(level)->getSetCount());
+		const uint32_t offset_bits = this->getCacheAtPtr(1)->getDecoder().getOffsetBits();
+		const size_t shard_count = std::min<size_t>(this->parallel_threads, class_count);
+		std::vector<std::unique_ptr<System>> shards;
+		for (size_t shard = 0; shard < shard_count; shard++) {
+			shards.push_back(std::make_unique<System>());
+			System &this_shard = *shards.back();
+			this_shard.quiet = true;
+			for (auto this_instruction: this->configuration)
+				std::invoke(this_instruction.first, this_shard, &this_instruction.second);
+			this_shard.ready.at(6) = true;
+			this_shard.event_log.setLevel(log_level_t::log_off, false);
+			this_shard.startRun();
+		}
+		auto isAccess = [](const Task &_task) {
+			return _task.getTaskType() == task_t::task_readAddress || _task.getTaskType() == task_t::task_writeAddress;
+		};
+		auto forwardEnds = [this](const Task &_task) {//fast-forwards of a parallel run end at an arrive time only
+			return this->fast_forwarding && this->forward_time != 0 && _task.getArriveTime() >= this->forward_time;
+		};
+		std::vector<uint64_t> service_clocks(this->task_queue.size(), 0);
+		std::vector<std::vector<size_t>> shard_tasks(shard_count);
+		size_t segment_begin{0};
+		while (segment_begin < this->task_queue.size()) {
+			size_t segment_end{segment_begin};
+			while (segment_end < this->task_queue.size() && isAccess(this->task_queue[segment_end]) &&
+				   !forwardEnds(this->task_queue[segment_end]))
+				segment_end++;
+			if (segment_end > segment_begin) {
+				for (std::vector<size_t> &this_shard_tasks: shard_tasks)
+					this_shard_tasks.clear();
+				for (size_t i = segment_begin; i < segment_end; i++) {//deal the segment out to the shards
+					uint32_t this_class = (this->task_queue[i].getTaskValue() >> offset_bits) & (class_count - 1);
+					shard_tasks[this_class % shard_count].push_back(i);
+				}
+				std::vector<std::exception_ptr> shard_errors(shard_count);
+				std::vector<std::thread> workers;
+				for (size_t shard = 0; shard < shard_count; shard++)
+					workers.emplace_back([&, shard]() {
+						try {
+							System &this_shard = *shards[shard];
+							for (size_t i: shard_tasks[shard]) {
+								const Task &this_task = this->task_queue[i];
+								uint64_t start_clock = this_shard.clock_count;
+								this_shard.runTask(this_task);
+								service_clocks[i] = this_shard.clock_count - start_clock;
+							}
+						} catch (...) {
+							shard_errors[shard] = std::current_exception();
+						}
+					});
+				for (std::thread &this_worker: workers)
+					this_worker.join();
+				for (const std::exception_ptr &this_error: shard_errors)
+					if (this_error != nullptr)
+						std::rethrow_exception(this_error);
+				for (size_t i = segment_begin; i < segment_end; i++)//replay the clock in task order
+					clock_count = std::max(clock_count, this->task_queue[i].getArriveTime()) + service_clocks[i];
+				this->mergeShards(shards);
+			}
+			if (segment_end < this->task_queue.size() && forwardEnds(this->task_queue[segment_end])) {
+				for (const auto &this_shard: shards)//the detailed run begins in every shard at once
+					this_shard->finishFastForward();
+				this->finishFastForward();
+			} else if (segment_end < this->task_queue.size()) {//a report, run on the merged counts
+				clock_count = std::max(clock_count, this->task_queue[segment_end].getArriveTime());
+				if (!this->runTask(this->task_queue[segment_end]))
+					break;
+				segment_end++;
+			}
+			segment_begin = segment_end;
+		}
+	}
+
+	/**
+	 * Set the Counts and Latency Histograms of Every Cache and Core to the Sum over the Shards of a Parallel Run
+	 */
+	void mergeShards(const std::vector<std::unique_ptr<System>> &_shards) {
+		for (uint32_t level = 1; level <= this->cache_count; level++) {
+			std::vector<Cache *> copies = this->getCacheCopies(level);
+			std::vector<std::vector<Cache *>> shard_copies;
+			for (const auto &this_shard: _shards)
+				shard_copies.push_back(this_shard->getCacheCopies(level));
+			for (size_t copy = 0; copy < copies.size(); copy++) {
+				std::vector<const Cache *> shard_caches;
+				for (const auto &this_shard_copies: shard_copies)
+					shard_caches.push_back(this_shard_copies[copy]);
+				copies[copy]->mergeCounts(shard_caches);
+			}
+		}
+		for (size_t core = 0; core < this->core_count; core++) {
+			CoherenceCount merged;
+			for (const auto &this_shard: _shards) {
+				const CoherenceCount &counts = this_shard->coherence_counts[core];
+				merged.reads += counts.reads;
+				merged.writes += counts.writes;
+				merged.invalidations_sent += counts.invalidations_sent;
+				merged.invalidations_received += counts.invalidations_received;
+				merged.interventions += counts.interventions;
+				merged.snoop_cycles += counts.snoop_cycles;
+			}
+			this->coherence_counts[core] = merged;
+			this->latency_histograms[core] = {};
+			for (const auto &this_shard: _shards)
+				for (size_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++)
+					this->latency_histograms[core][bucket] += this_shard->latency_histograms[core][bucket];
 		}
-		return this_cache_ptr;
 	}
 
 	/**
@@ -73,160 +720,576 @@ private:
 		this->ready.at(6) = true;
 	}
 
-	[[nodiscard]] uint64_t readCache(Cache *_cache, const uint32_t &_address, const uint64_t &_clock_when_called) {
-		reportCall(_clock_when_called, _cache, "READ", _address);
-		std::string status{""};
-		uint64_t elapsed_clock{_clock_when_called};//elapsed clock cycles default is 0
-		if (_cache == nullptr) {//If this is called by digging into Memory (bottom)
-			elapsed_clock += memory_latency;//Tag is pseudo found and add memory latency to elapsed clock
-			status = "M_R_SUCCESS";
-			reportReturn(elapsed_clock, _cache, "READ", _address, status, false);
-		} else {//If this is called by digging into Next Parental Cache (one level below)
-			if (_cache->updateExistingTag(_address, elapsed_clock,
-										  false)) {//if there's a tag match from a set -- READ HIT
-				status = "C_R_HIT";
-				reportReturn(elapsed_clock, _cache, "READ", _address, status, false);
-			} else {//if there's NO tag match from a set -- READ MISS
-				reportReturn(elapsed_clock, _cache, "READ", _address, "C_R_MISS$GENERAL", false);
-				elapsed_clock = readCache(_cache->getParentPtr(), _address,
-										  elapsed_clock);//sum latencies of parents to read
-				if (!_cache->allocateNewTag(_address, false, elapsed_clock)) {//if allocation failed (full)
-					auto poped_db = _cache->popFlushLRUTag(_address);//pop LRU tag and flush LRU field
-					if (poped_db.first) {//if the poped LRU tag is dirty, sync the address with parental cache (write)
-						status = "C_R_MISS$ALLOC_FAILED$POP_DIRTY";
-						reportReturn(elapsed_clock, _cache, "READ", _address, status, false);
-						elapsed_clock = writeCache(_cache->getParentPtr(), poped_db.second, elapsed_clock);//Write prt
-					} else {//if the popped LRU tag is non-dirty, discard the poped tag
-						status = "C_R_MISS$ALLOC_FAILED$POP_CLEAN";
-						reportReturn(elapsed_clock, _cache, "READ", _address, status, false);
-					}
-					if (!_cache->allocateNewTag(_address, false, elapsed_clock))//try to alloc again after pop
-						throw std::runtime_error("ERR Alloc after Popping failed");
-				} else {//if allocation suceeded without popping
-					status = "C_R_MISS$ALLOC_SUCCESS";
-					reportReturn(elapsed_clock, _cache, "READ", _address, status, false);
+	/**
+	 * Clock Cycles a Read of an Address Takes from a Level down, without Counting or Changing Anything
+	 * @param _path Levels of the core, top cache first
+	 * @param _level Index into the path of the first level read, cache_count for memory
+	 */
+	[[nodiscard]] uint64_t fetchLatency(Cache *const *_path, const size_t &_level, const address_t &_address) const {
+		uint64_t latency{0};
+		for (size_t level = _level; level < this->cache_count; level++) {
+			latency += _path[level]->getLatency();
+			if (_path[level]->containsTag(_path[level]->addressDecode(_address)))
+				return latency;
+		}
+		return latency + this->memory_latency;
+	}
+
+	/**
+	 * Prefetch a Block into a Level (Next-Line and Stride Prefetchers)
+	 * The victim leaves through the victim cache like a demand victim, a dirty one written back in the background;
+	 * a block already cached is not fetched again
+	 * @param _path Levels of the core, top cache first
+	 * @param _level Index into the path of the prefetching level
+	 * @param _block Block number (address >> offset bits) to prefetch
+	 * @param _clock Clock the prefetch is issued at
+	 */
+	void prefetchBlock(Cache *const *_path, const size_t &_level, const address_t &_block, const uint64_t &_clock) {
+		Cache *this_cache = _path[_level];
+		const uint32_t offset_bits = this_cache->getDecoder().getOffsetBits();
+		if (_block > (ADDRESS_MAX >> offset_bits))
+			return;
+		const address_t address = _block << offset_bits;
+		const DecodedAddress decoded = this_cache->addressDecode(address);
+		if (this_cache->containsTag(decoded))
+			return;
+		Prefetcher &prefetcher = this_cache->getPrefetcher();
+		const uint64_t ready_clock = _clock + this->fetchLatency(_path, _level + 1, address);
+		if (!this_cache->allocateNewTag(decoded, false)) {
+			auto poped_db = this_cache->popFlushVictimTag(decoded);
+			prefetcher.evicted(poped_db.second >> offset_bits, true);
+			if (this->evictBlock(_path, _level, poped_db) && poped_db.first)
+				(void) this->writeWalk(_path, _level + 1, poped_db.second, _clock);
+			if (!this_cache->allocateNewTag(decoded, false))
+				throw std::runtime_error("ERR Alloc after Popping failed");
+		}
+		prefetcher.filled(_block, ready_clock);
+	}
+
+	/**
+	 * Show a Demand Access to the Prefetcher of a Level and Issue the Prefetches it Asks for
+	 * @param _path Levels of the core, top cache first
+	 * @param _level Index into the path of the level accessed
+	 * @param _address Raw address demanded
+	 * @param _hit If the level held the block
+	 * @param _clock Clock of the demand
+	 * @return Clock cycles the demand waits for a late prefetch of its own block
+	 */
+	uint64_t prefetchOnDemand(Cache *const *_path, const size_t &_level, const address_t &_address, const bool &_hit,
+							  const uint64_t &_clock) {
+		Prefetcher &prefetcher = _path[_level]->getPrefetcher();
+		const address_t block = _address >> _path[_level]->getDecoder().getOffsetBits();
+		auto prefetched_wait = prefetcher.demand(block, _hit, _clock);
+		prefetcher.train(block, _hit, prefetched_wait.first, this->prefetch_targets);
+		for (const address_t &this_target: this->prefetch_targets)
+			this->prefetchBlock(_path, _level, this_target, _clock + prefetched_wait.second);
+		return prefetched_wait.second;
+	}
+
+	/**
+	 * Offer a Demand Read Miss to the Stream Buffer of a Level, then Refill the Buffer
+	 * @param _path Levels of the core, top cache first
+	 * @param _level Index into the path of the level that missed
+	 * @param _address Raw address demanded
+	 * @param _clock Clock of the miss, moved to when the block is ready if the buffer supplies it late
+	 * @return True if the stream buffer supplies the block
+	 */
+	bool takeFromStreamBuffer(Cache *const *_path, const size_t &_level, const address_t &_address, uint64_t &_clock) {
+		Prefetcher &prefetcher = _path[_level]->getPrefetcher();
+		const uint32_t offset_bits = _path[_level]->getDecoder().getOffsetBits();
+		const address_t block = _address >> offset_bits;
+		uint64_t ready_clock{0};
+		bool supplied = prefetcher.takeStreamBlock(block, ready_clock);
+		if (!supplied)
+			(void) prefetcher.demand(block, false, _clock);
+		prefetcher.streamTargets(block, this->prefetch_targets);
+		for (const address_t &this_target: this->prefetch_targets)
+			if (this_target <= (ADDRESS_MAX >> offset_bits))
+				prefetcher.streamFilled(this_target,
+										_clock + this->fetchLatency(_path, _level + 1, this_target << offset_bits));
+		if (supplied && ready_clock > _clock) {
+			prefetcher.streamLate();
+			_clock = ready_clock;
+		}
+		return supplied;
+	}
+
+	/**
+	 * Invalidate an Address in Every Level above a Level, and their Victim Caches (Inclusive Hierarchies)
+	 * A shared level reaches the private levels of every core; shared levels above it are visited once
+	 * @param _path Levels of the core, top cache first
+	 * @param _level Index into the path of the level evicting the address
+	 * @param _address Raw address evicted
+	 * @return True if a copy invalidated was dirty
+	 */
+	bool backInvalidate(Cache *const *_path, const size_t &_level, const address_t &_address) {
+		bool any_dirty{false};
+		const bool shared = _level >= this->private_levels;
+		for (uint16_t core = 0; core < (shared ? this->core_count : 1); core++) {
+			Cache *const *path = shared ? this->getCorePath(core) : _path;
+			for (size_t level = 0; level < _level; level++) {
+				if (core > 0 && level >= this->private_levels)
+					break;
+				auto present_dirty = snoopLevel(path[level], _address, true);
+				if (present_dirty.first)
+					_path[_level]->countBackInvalidation();
+				any_dirty |= present_dirty.second;
+			}
+		}
+		return any_dirty;
+	}
+
+	/**
+	 * Prepare a Block Evicted from a Level for Leaving it
+	 * Inclusive hierarchies invalidate it above first (a dirty copy makes it dirty); then the victim cache of the
+	 * level, if any, takes it in and hands over the block it pushes out instead
+	 * @param _path Levels of the core, top cache first
+	 * @param _level Index into the path of the evicting level
+	 * @param _victim [If Dirty][Raw Address] of the evicted block, replaced by the block that leaves the level
+	 * @return True if a block leaves the level, false if the victim cache kept it without pushing one out
+	 */
+	bool evictBlock(Cache *const *_path, const size_t &_level, std::pair<bool, address_t> &_victim) {
+		if (this->inclusion == inclusion_t::inclusion_inclusive && _level > 0)
+			_victim.first |= this->backInvalidate(_path, _level, _victim.second);
+		VictimCache &victim_cache = _path[_level]->getVictimCache();
+		return !victim_cache.isEnabled() || victim_cache.insert(_victim);
+	}
+
+	/**
+	 * Move a Block into a Level from the Victim Cache of that Level, if it is there
+	 * @return True if the victim cache held the block dirty
+	 */
+	bool takeFromVictimCache(Cache *const *_path, const size_t &_level, const address_t &_address) {
+		bool dirty{false};
+		VictimCache &victim_cache = _path[_level]->getVictimCache();
+		return victim_cache.isEnabled() && victim_cache.take(_address, dirty) && dirty;
+	}
+
+	/**
+	 * Swap a Block Evicted from a Level into the Level below (Exclusive Hierarchies)
+	 * The block it evicts there moves down in turn, down to memory, which keeps dirty blocks only
+	 * @param _path Levels of the core, top cache first
+	 * @param _level Index into the path of the level taking the block, cache_count for memory
+	 * @param _block [If Dirty][Raw Address] of the block
+	 * @param _clock_when_called Clock when the swap starts
+	 * @return Clock when the swap completes
+	 */
+	[[nodiscard]] uint64_t swapDown(Cache *const *_path, size_t _level, std::pair<bool, address_t> _block,
+									const uint64_t &_clock_when_called) {
+		uint64_t elapsed_clock{_clock_when_called};
+		for (; _level < this->cache_count; _level++) {
+			Cache *this_cache = _path[_level];
+			const DecodedAddress decoded = this_cache->addressDecode(_block.second);
+			if (_block.first)
+				_path[_level - 1]->countWriteBack();
+			elapsed_clock += this_cache->getLatency();//takes this cache's latency to write
+			_block.first |= this->takeFromVictimCache(_path, _level, _block.second);
+			if (this_cache->mergeTag(decoded, _block.first) || this_cache->allocateNewTag(decoded, _block.first))
+				return elapsed_clock;
+			auto poped_db = this_cache->popFlushVictimTag(decoded);
+			if (!this_cache->allocateNewTag(decoded, _block.first))
+				throw std::runtime_error("ERR Alloc after Popping failed");
+			if (!this->evictBlock(_path, _level, poped_db))
+				return elapsed_clock;
+			_block = poped_db;
+		}
+		if (_block.first)//memory keeps dirty blocks only
+			elapsed_clock = this->writeWalk(_path, this->cache_count, _block.second, elapsed_clock);
+		return elapsed_clock;
+	}
+
+	/**
+	 * Keep the Hierarchy's Inclusion Policy after a Write Allocated an Address in a Level
+	 * Takes the block out of the victim cache of the level; exclusive hierarchies take it out of the levels below,
+	 * inclusive ones install it in every level below lacking it (bottom first, write-backs in the background)
+	 * @param _path Levels of the core, top cache first
+	 * @param _level Index into the path of the level that allocated the address
+	 * @param _address Raw address allocated
+	 * @param _clock Clock of the allocation
+	 */
+	void claimBlock(Cache *const *_path, const size_t &_level, const address_t &_address, const uint64_t &_clock) {
+		(void) this->takeFromVictimCache(_path, _level, _address);//the write makes it dirty anyway
+		if (this->inclusion == inclusion_t::inclusion_exclusive) {
+			for (size_t level = _level + 1; level < this->cache_count; level++) {
+				(void) _path[level]->snoopTag(_path[level]->addressDecode(_address), true);
+				(void) this->takeFromVictimCache(_path, level, _address);
+			}
+		} else if (this->inclusion == inclusion_t::inclusion_inclusive) {
+			size_t level = _level + 1;
+			while (level < this->cache_count && !_path[level]->containsTag(_path[level]->addressDecode(_address)))
+				level++;
+			while (level-- > _level + 1) {
+				Cache *this_cache = _path[level];
+				const DecodedAddress decoded = this_cache->addressDecode(_address);
+				const bool dirty = this->takeFromVictimCache(_path, level, _address);
+				if (this_cache->allocateNewTag(decoded, dirty))
+					continue;
+				auto poped_db = this_cache->popFlushVictimTag(decoded);
+				if (!this_cache->allocateNewTag(decoded, dirty))
+					throw std::runtime_error("ERR Alloc after Popping failed");
+				if (this->evictBlock(_path, level, poped_db) && poped_db.first)
+					(void) this->writeWalk(_path, level + 1, poped_db.second, _clock);
+			}
+		}
+	}
+
+	/**
+	 * Read an Address through the Levels of a Core
+	 * Walks down the path until a level hits (or memory answers the read), then walks back up filling every level
+	 * that missed, writing dirty victims one level down. Each level decodes the address once.
+	 * Exclusive hierarchies fill the top level only, moving the block out of the level that held it, and swap
+	 * every victim into the level below instead.
+	 * @param _path Levels of the core, top cache first
+	 * @param _address Raw address to be read
+	 * @param _clock_when_called Clock when the read starts
+	 * @return Clock when the read completes
+	 */
+	[[nodiscard]] uint64_t readWalk(Cache *const *_path, const address_t &_address, const uint64_t &_clock_when_called) {
+		uint64_t elapsed_clock{_clock_when_called};
+		const bool exclusive = this->inclusion == inclusion_t::inclusion_exclusive;
+		bool supplied{false};
+		bool fill_dirty{false};//the block arrives dirty from a lower level (exclusive) or a victim cache
+		size_t level{0};
+		for (; level < this->cache_count; level++) {//down: probe every level until one hits
+			Cache *this_cache = _path[level];
+			DecodedAddress &decoded = this->walk_decoded[level];
+			decoded = this_cache->addressDecode(_address);
+			event_log.call(elapsed_clock, this_cache->getId(), oper_t::oper_read, decoded);
+			const bool moved_dirty = exclusive && level > 0 && this_cache->isDirtyTag(decoded);
+			if (this_cache->updateExistingTag(decoded, false, false)) {//if there's a tag match from a set -- READ HIT
+				event_log.step(elapsed_clock, status_t::cache_read_hit);
+				if (exclusive && level > 0) {//the block moves up to the top level
+					(void) this_cache->snoopTag(decoded, true);
+					fill_dirty = moved_dirty;
 				}
+				const uint64_t fill_clock = this->non_blocking ? this_cache->getMshrFile().merge(
+						_address >> this_cache->getDecoder().getOffsetBits(), elapsed_clock) : 0;
+				if (this->prefetching && this_cache->getPrefetcher().isEnabled() &&
+					!this_cache->getPrefetcher().isStreamBuffer())
+					elapsed_clock += this->prefetchOnDemand(_path, level, _address, true, elapsed_clock);
+				elapsed_clock += this_cache->getLatency();//takes this cache's latency to read
+				elapsed_clock = std::max(elapsed_clock, fill_clock);//wait for the outstanding fill merged into
+				event_log.ret(elapsed_clock, status_t::cache_read_hit);
+				supplied = true;
+				break;
 			}
-			elapsed_clock += _cache->getLatency();//takes this cache's latency to read
+			event_log.step(elapsed_clock, status_t::cache_read_miss);//if there's NO tag match from a set -- READ MISS
+			if (this->non_blocking)//wait for a free register if all are busy
+				this->walk_mshrs[level] = this_cache->getMshrFile().acquire(
+						_address >> this_cache->getDecoder().getOffsetBits(), elapsed_clock);
+			if (this->prefetching && this_cache->getPrefetcher().isStreamBuffer() &&
+				this->takeFromStreamBuffer(_path, level, _address, elapsed_clock)) {//filled from the stream buffer
+				supplied = true;
+				level++;
+				break;
+			}
+			if (this_cache->getVictimCache().isEnabled() &&
+				this_cache->getVictimCache().take(_address, fill_dirty)) {//filled from the victim cache
+				supplied = true;
+				level++;
+				break;
+			}
+			if (this->core_count > 1 && level + 1 == this->private_levels)//leaving the private levels
+				elapsed_clock = this->snoopOtherCores(_address, elapsed_clock, false);
+		}
+		if (!supplied) {//every level missed: memory, the tag is pseudo found
+			event_log.call(elapsed_clock, 0, oper_t::oper_read, DecodedAddress{_address});
+			elapsed_clock += memory_latency;
+			event_log.step(elapsed_clock, status_t::mem_read_success);
+			event_log.ret(elapsed_clock, status_t::mem_read_success);
+		}
+		const size_t dirty_level = exclusive ? 0 : level - supplied;//the level a dirty block arrives in
+		while (level-- > 0) {//up: allocate the block in every level that missed
+			Cache *this_cache = _path[level];
+			const DecodedAddress &decoded = this->walk_decoded[level];
+			const bool dirty = fill_dirty && level == dirty_level;
+			status_t status{status_t::cache_read_miss_alloc};
+			if (exclusive && level > 0)//the block only passes through
+				status = status_t::cache_read_miss;
+			else if (!this_cache->allocateNewTag(decoded, dirty)) {//if allocation failed (full)
+				auto poped_db = this_cache->popFlushVictimTag(decoded);//pop victim tag and flush its field
+				if (this->prefetching && this_cache->getPrefetcher().isEnabled())
+					this_cache->getPrefetcher().evicted(poped_db.second >> this_cache->getDecoder().getOffsetBits(), false);
+				const bool leaves = this->evictBlock(_path, level, poped_db);
+				if (leaves && exclusive) {//the victim moves one level down, clean or dirty
+					status = poped_db.first ? status_t::cache_read_miss_pop_dirty : status_t::cache_read_miss_pop_clean;
+					event_log.step(elapsed_clock, status);
+					elapsed_clock = this->swapDown(_path, level + 1, poped_db, elapsed_clock);
+				} else if (leaves && poped_db.first) {//if the poped victim tag is dirty, sync the address with parental cache (write)
+					status = status_t::cache_read_miss_pop_dirty;
+					event_log.step(elapsed_clock, status);
+					elapsed_clock = this->writeWalk(_path, level + 1, poped_db.second, elapsed_clock);
+				} else {//if the popped victim tag is non-dirty, discard the poped tag
+					status = status_t::cache_read_miss_pop_clean;
+					event_log.step(elapsed_clock, status);
+				}
+				if (!this_cache->allocateNewTag(decoded, dirty))//try to alloc again after pop
+					throw std::runtime_error("ERR Alloc after Popping failed");
+			} else//if allocation suceeded without popping
+				event_log.step(elapsed_clock, status);
+			if (this->prefetching && this_cache->getPrefetcher().isEnabled() &&
+				!this_cache->getPrefetcher().isStreamBuffer())
+				(void) this->prefetchOnDemand(_path, level, _address, false, elapsed_clock);
+			elapsed_clock += this_cache->getLatency();//takes this cache's latency to read
+			if (this->non_blocking)
+				this_cache->getMshrFile().release(this->walk_mshrs[level], elapsed_clock);
+			event_log.ret(elapsed_clock, status);
 		}
-		reportReturn(elapsed_clock, _cache, "READ", _address, status, true);
 		return elapsed_clock;
 	}
 
-	[[nodiscard]] uint64_t writeCache(Cache *_cache, const uint32_t &_address, const uint64_t &_clock_when_called) {
-		reportCall(_clock_when_called, _cache, "WRITE", _address);
-		std::string status{""};
-		uint64_t elapsed_clock{_clock_when_called};//elapsed clock cycles default is 0
-		if (_cache == nullptr) {//If this is called by digging into Memory (bottom)
-			status = "M_W_SUCCESS";
-			reportReturn(elapsed_clock, _cache, "WRITE", _address, status, false);
-			elapsed_clock += memory_latency;//Tag is pseudo written and add memory latency to elapsed clock
-		} else {//If this is called by digging into Next Parental Cache (one level below)
+	/**
+	 * Write an Address through the Levels of a Core, Starting at a Given Level
+	 * A write stops at the first level that keeps it. It moves one level down for a dirty victim (Write-Back,
+	 * carrying the victim's address) or a miss (Write-Thru, carrying the same address), down to memory at most.
+	 * Levels it passed through return only once it stops, all at the clock it stopped at.
+	 * @param _path Levels of the core, top cache first
+	 * @param _level Index of the first level into the path, cache_count for memory
+	 * @param _address Raw address to be written
+	 * @param _clock_when_called Clock when the write starts
+	 * @return Clock when the write completes
+	 */
+	[[nodiscard]] uint64_t writeWalk(Cache *const *_path, size_t _level, address_t _address,
+									 const uint64_t &_clock_when_called) {
+		uint64_t elapsed_clock{_clock_when_called};
+		bool demand = _level == 0;//only writes of the core itself train prefetchers, not write-backs
+		const size_t passed_base = this->walk_statuses.size();
+		if (_level > 0)//a dirty block written back by the level above
+			_path[_level - 1]->countWriteBack();
+		for (;; _level++) {
+			if (_level == this->cache_count) {//memory, the tag is pseudo written
+				event_log.call(elapsed_clock, 0, oper_t::oper_write, DecodedAddress{_address});
+				event_log.step(elapsed_clock, status_t::mem_write_success);
+				elapsed_clock += memory_latency;
+				event_log.ret(elapsed_clock, status_t::mem_write_success);
+				break;
+			}
+			Cache *this_cache = _path[_level];
+			const DecodedAddress decoded = this_cache->addressDecode(_address);
+			event_log.call(elapsed_clock, this_cache->getId(), oper_t::oper_write, decoded);
+			status_t status{status_t::status_none};
+			const bool prefetch_demand = demand && this->prefetching && this_cache->getPrefetcher().isEnabled() &&
+										 !this_cache->getPrefetcher().isStreamBuffer();
 			if (read_write_policy == POLICY_WBWA) {//if the policy is write-back and write-allocate
-				elapsed_clock += _cache->getLatency();//takes this cache's latency to write
-				if (_cache->updateExistingTag(_address, elapsed_clock,
-											  true)) {//if there's a tag match, then set dirty -- WRITE HIT
-					status = "C_R_HIT$MARKED_DIRTY$WB";
-					reportReturn(elapsed_clock, _cache, "WRITE", _address, status, false);
-				} else {//if there's NO tag match from a set to set dirty-- WRITE MISS
-//TO-DO HERE: Should there be a read from parent cache?
-					if (!_cache->allocateNewTag(_address, true, elapsed_clock)) {//while allocation failed
-						auto poped_db = _cache->popFlushLRUTag(_address);//pop LRU tag and flush LRU field
-						if (poped_db.first) {//if the poped LRU tag is dirty, write the address with parental cache
-							status = "C_W_MISS$ALLOC_FAILED$POP_DIRTY$WB";
-							reportReturn(elapsed_clock, _cache, "WRITE", _address, status, false);
-							elapsed_clock = writeCache(_cache->getParentPtr(), poped_db.second, elapsed_clock);//W Prt
-						} else {
-							status = "C_W_MISS$ALLOC_FAILED$POP_CLEAN$WB";
-							reportReturn(elapsed_clock, _cache, "WRITE", _address, status, false);
-						}
-						if (!_cache->allocateNewTag(_address, true, elapsed_clock))//try to alloc agn after pop
-							throw std::runtime_error("ERR Alloc after Popping failed");
-					} else {
-						status = "C_W_MISS$ALLOC_SUCCESS$WB";
-						reportReturn(elapsed_clock, _cache, "WRITE", _address, status, false);
+				elapsed_clock += this_cache->getLatency();//takes this cache's latency to write
+				if (this_cache->updateExistingTag(decoded, true, true)) {//if there's a tag match, then set dirty -- WRITE HIT
+					status = status_t::cache_write_hit_wb;
+					event_log.step(elapsed_clock, status);
+					if (prefetch_demand)
+						elapsed_clock += this->prefetchOnDemand(_path, _level, _address, true, elapsed_clock);
+				} else if (!this_cache->allocateNewTag(decoded, true)) {//WRITE MISS and allocation failed
+					auto poped_db = this_cache->popFlushVictimTag(decoded);//pop victim tag and flush its field
+					if (this->prefetching && this_cache->getPrefetcher().isEnabled())
+						this_cache->getPrefetcher().evicted(poped_db.second >> this_cache->getDecoder().getOffsetBits(),
+															false);
+					const bool leaves = this->evictBlock(_path, _level, poped_db);
+					status = leaves && poped_db.first ? status_t::cache_write_miss_pop_dirty_wb :
+							 status_t::cache_write_miss_pop_clean_wb;
+					event_log.step(elapsed_clock, status);
+					if (!this_cache->allocateNewTag(decoded, true))//try to alloc agn after pop
+						throw std::runtime_error("ERR Alloc after Popping failed");
+					this->claimBlock(_path, _level, _address, elapsed_clock);
+					if (prefetch_demand)
+						(void) this->prefetchOnDemand(_path, _level, _address, false, elapsed_clock);
+					if (leaves && this->inclusion == inclusion_t::inclusion_exclusive)//the victim moves one level down
+						elapsed_clock = this->swapDown(_path, _level + 1, poped_db, elapsed_clock);
+					else if (leaves && poped_db.first) {//if the poped victim tag is dirty, write the address in the parent
+						this_cache->countWriteBack();
+						this->walk_statuses.push_back(status);
+						_address = poped_db.second;
+						demand = false;
+						continue;
 					}
+				} else {
+					status = status_t::cache_write_miss_alloc_wb;
+					event_log.step(elapsed_clock, status);
+					this->claimBlock(_path, _level, _address, elapsed_clock);
+					if (prefetch_demand)
+						(void) this->prefetchOnDemand(_path, _level, _address, false, elapsed_clock);
 				}
-			} else if (read_write_policy == POLICY_WTNWA) {//if the policy is write-thru and non-write allocate
-				if (_cache->updateExistingTag(_address, elapsed_clock,
-											  false)) {//if there's a tag match, no need dirty-- WRITE HIT
-					status = "C_W_HIT$WT";
-					reportReturn(elapsed_clock, _cache, "WRITE", _address, status, false);
-					elapsed_clock += _cache->getLatency();//takes this cache's latency to write
-				} else {//if there's NO tag match from a set - WRITE MISS
-					status = "C_W_MISS$PROPAGATE$WT";
-					reportReturn(elapsed_clock, _cache, "WRITE", _address, status, false);
-					elapsed_clock = writeCache(_cache->getParentPtr(), _address, elapsed_clock);//just write in parent.
+			} else {//if the policy is write-thru and non-write allocate
+				if (this_cache->updateExistingTag(decoded, false, true)) {//if there's a tag match, no need dirty-- WRITE HIT
+					status = status_t::cache_write_hit_wt;
+					event_log.step(elapsed_clock, status);
+					if (prefetch_demand)
+						elapsed_clock += this->prefetchOnDemand(_path, _level, _address, true, elapsed_clock);
+					elapsed_clock += this_cache->getLatency();//takes this cache's latency to write
+				} else {//if there's NO tag match from a set - WRITE MISS, just write in parent
+					event_log.step(elapsed_clock, status_t::cache_write_miss_propagate_wt);
+					if (prefetch_demand)
+						(void) this->prefetchOnDemand(_path, _level, _address, false, elapsed_clock);
+					this->walk_statuses.push_back(status_t::cache_write_miss_propagate_wt);
+					this_cache->countWriteThrough();
+					continue;
 				}
 			}
+			event_log.ret(elapsed_clock, status);
+			break;
+		}
+		while (this->walk_statuses.size() > passed_base) {//the levels passed through, innermost first
+			event_log.ret(elapsed_clock, this->walk_statuses.back());
+			this->walk_statuses.pop_back();
 		}
-		reportReturn(elapsed_clock, _cache, "WRITE", _address, status, true);
 		return elapsed_clock;
 	}
 
-	void reportReturn(const uint64_t &_time, Cache *_cache, const std::string &_oper, const uint32_t &_address,
-					  const std::string &_status, const bool &_go_back) {
-		std::string cache = _cache == nullptr ? "MEM" : ("L" + std::to_string(_cache->getId()));
-		if (report_writer.second == 0)
-			throw std::runtime_error("ERR Tab Count Less than 0");
-		if (_go_back)
-			report_writer.second--;
-		std::string front_dashes;
-		for (size_t i = 0; i < this->report_writer.second; i++) front_dashes += "\t";
-		report_writer.first
-				<< front_dashes;
-		if (_go_back)
-			report_writer.first
-					<< "}";
-		else
-			report_writer.first
-					<< "↓[";
-		report_writer.first
-				<< _time
-				<< "←"
-				/*				<< cache << "::"
-								<< _oper << "("
-								<< _address << ")->"*/
-				<< _status << (_go_back ? "" : "]") << std::endl;
-
-	}
-
-	void reportCall(const uint64_t &_time, Cache *_cache, const std::string &_oper, const uint32_t &_address) {
-		std::string cache = _cache == nullptr ? "MEM" : ("L" + std::to_string(_cache->getId()));
-		auto decoded_address =
-				_cache == nullptr ? std::tuple<uint32_t, uint32_t, uint32_t>{0, 0, 0} : _cache->addressDecode(_address);
-		std::string front_dashes;
-		for (size_t i = 0; i < this->report_writer.second; i++) front_dashes += "\t";
-		std::string first_bin, second_bin, third_bin;
-		first_bin = std::bitset<32>(std::get<0>(decoded_address)).to_string();
-		second_bin = std::bitset<32>(std::get<1>(decoded_address)).to_string();
-		third_bin = std::bitset<32>(std::get<2>(decoded_address)).to_string();
-		third_bin.erase(0, std::min(third_bin.find_first_not_of('0'), third_bin.size() - 1));
-		report_writer.first
-				<< front_dashes
-				<< _time << "→"
-				<< cache << "::"
-				<< _oper << "({";
-		report_writer.first
-				<< std::get<0>(decoded_address) << "(";
-		first_bin.erase(0, std::min(first_bin.find_first_not_of('0'), first_bin.size() - 1));
-		report_writer.first
-				<< first_bin << "):";
-		report_writer.first
-				<< std::get<1>(decoded_address) << "(";
-		second_bin.erase(0, std::min(second_bin.find_first_not_of('0'), second_bin.size() - 1));
-		report_writer.first
-				<< second_bin << "):";
-		report_writer.first
-				<< std::get<2>(decoded_address) << "(";
-		third_bin.erase(0, std::min(third_bin.find_first_not_of('0'), third_bin.size() - 1));
-		report_writer.first
-				<< third_bin << ")}="
-				<< _address << "){"
-				<< std::endl;
-		report_writer.second++;
+	/**
+	 * Snoop the Private Levels of Every Other Core for a Block, Functionally (Fast-Forward)
+	 * Changes the same blocks as snoopOtherCores, without clock cycles or coherence counts
+	 */
+	void forwardSnoop(const address_t &_address, const bool &_invalidate) {
+		for (uint16_t core = 0; core < this->core_count; core++) {
+			if (core == this->current_core) continue;
+			bool any_dirty{false};
+			Cache *const *path = this->getCorePath(core);
+			for (uint32_t level = 0; level < this->private_levels; level++)
+				any_dirty |= snoopLevel(path[level], _address, _invalidate).second;
+			if (any_dirty)
+				this->forwardWrite(path, this->private_levels, _address);
+		}
 	}
 
+	/**
+	 * Swap a Block Evicted from a Level into the Level below, Functionally (Fast-Forward, Exclusive Hierarchies)
+	 * Changes the same blocks as swapDown; memory needs no update
+	 */
+	void forwardSwapDown(Cache *const *_path, size_t _level, std::pair<bool, address_t> _block) {
+		for (; _level < this->cache_count; _level++) {
+			Cache *this_cache = _path[_level];
+			const DecodedAddress decoded = this_cache->addressDecode(_block.second);
+			_block.first |= this->takeFromVictimCache(_path, _level, _block.second);
+			if (this_cache->mergeTag(decoded, _block.first) || this_cache->allocateNewTag(decoded, _block.first))
+				return;
+			auto poped_db = this_cache->popFlushVictimTag(decoded);
+			if (!this_cache->allocateNewTag(decoded, _block.first))
+				throw std::runtime_error("ERR Alloc after Popping failed");
+			if (!this->evictBlock(_path, _level, poped_db))
+				return;
+			_block = poped_db;
+		}
+	}
+
+	/**
+	 * Keep the Hierarchy's Inclusion Policy after a Write Allocated an Address in a Level, Functionally (Fast-Forward)
+	 * Changes the same blocks as claimBlock
+	 */
+	void forwardClaim(Cache *const *_path, const size_t &_level, const address_t &_address) {
+		(void) this->takeFromVictimCache(_path, _level, _address);
+		if (this->inclusion == inclusion_t::inclusion_exclusive) {
+			for (size_t level = _level + 1; level < this->cache_count; level++) {
+				(void) _path[level]->snoopTag(_path[level]->addressDecode(_address), true);
+				(void) this->takeFromVictimCache(_path, level, _address);
+			}
+		} else if (this->inclusion == inclusion_t::inclusion_inclusive) {
+			size_t level = _level + 1;
+			while (level < this->cache_count && !_path[level]->containsTag(_path[level]->addressDecode(_address)))
+				level++;
+			while (level-- > _level + 1) {
+				Cache *this_cache = _path[level];
+				const DecodedAddress decoded = this_cache->addressDecode(_address);
+				const bool dirty = this->takeFromVictimCache(_path, level, _address);
+				if (this_cache->allocateNewTag(decoded, dirty))
+					continue;
+				auto poped_db = this_cache->popFlushVictimTag(decoded);
+				if (!this_cache->allocateNewTag(decoded, dirty))
+					throw std::runtime_error("ERR Alloc after Popping failed");
+				if (this->evictBlock(_path, level, poped_db) && poped_db.first)
+					this->forwardWrite(_path, level + 1, poped_db.second);
+			}
+		}
+	}
+
+	/**
+	 * Read an Address through the Levels of a Core, Functionally (Fast-Forward)
+	 * Leaves the same tags, dirty bits, replacement state, victim caches and coherence state as readWalk, without
+	 * clock cycles, MSHRs, prefetchers or the event log
+	 * @param _path Levels of the core, top cache first
+	 * @param _address Raw address to be read
+	 */
+	void forwardRead(Cache *const *_path, const address_t &_address) {
+		const bool exclusive = this->inclusion == inclusion_t::inclusion_exclusive;
+		bool supplied{false};
+		bool fill_dirty{false};
+		size_t level{0};
+		for (; level < this->cache_count; level++) {//down: probe every level until one hits
+			Cache *this_cache = _path[level];
+			DecodedAddress &decoded = this->walk_decoded[level];
+			decoded = this_cache->addressDecode(_address);
+			const bool moved_dirty = exclusive && level > 0 && this_cache->isDirtyTag(decoded);
+			if (this_cache->touchTag(decoded, false)) {
+				if (exclusive && level > 0) {//the block moves up to the top level
+					(void) this_cache->snoopTag(decoded, true);
+					fill_dirty = moved_dirty;
+				}
+				supplied = true;
+				break;
+			}
+			if (this_cache->getVictimCache().isEnabled() && this_cache->getVictimCache().take(_address, fill_dirty)) {
+				supplied = true;
+				level++;
+				break;
+			}
+			if (this->core_count > 1 && level + 1 == this->private_levels)//leaving the private levels
+				this->forwardSnoop(_address, false);
+		}
+		const size_t dirty_level = exclusive ? 0 : level - supplied;
+		while (level-- > 0) {//up: allocate the block in every level that missed
+			if (exclusive && level > 0)//the block only passes through
+				continue;
+			Cache *this_cache = _path[level];
+			const DecodedAddress &decoded = this->walk_decoded[level];
+			const bool dirty = fill_dirty && level == dirty_level;
+			if (this_cache->allocateNewTag(decoded, dirty))
+				continue;
+			auto poped_db = this_cache->popFlushVictimTag(decoded);
+			if (this->evictBlock(_path, level, poped_db)) {
+				if (exclusive)
+					this->forwardSwapDown(_path, level + 1, poped_db);
+				else if (poped_db.first)
+					this->forwardWrite(_path, level + 1, poped_db.second);
+			}
+			if (!this_cache->allocateNewTag(decoded, dirty))
+				throw std::runtime_error("ERR Alloc after Popping failed");
+		}
+	}
+
+	/**
+	 * Write an Address through the Levels of a Core, Starting at a Given Level, Functionally (Fast-Forward)
+	 * Leaves the same tags, dirty bits, replacement state, victim caches and coherence state as writeWalk, without
+	 * clock cycles, prefetchers or the event log
+	 * @param _path Levels of the core, top cache first
+	 * @param _level Index of the first level into the path, cache_count for memory
+	 * @param _address Raw address to be written
+	 */
+	void forwardWrite(Cache *const *_path, size_t _level, address_t _address) {
+		for (; _level < this->cache_count; _level++) {//memory needs no update
+			Cache *this_cache = _path[_level];
+			const DecodedAddress decoded = this_cache->addressDecode(_address);
+			if (read_write_policy != POLICY_WBWA) {//write-thru: a miss is written in the parent
+				if (this_cache->touchTag(decoded, false))
+					return;
+				continue;
+			}
+			if (this_cache->touchTag(decoded, true))
+				return;
+			if (this_cache->allocateNewTag(decoded, true)) {
+				this->forwardClaim(_path, _level, _address);
+				return;
+			}
+			auto poped_db = this_cache->popFlushVictimTag(decoded);
+			const bool leaves = this->evictBlock(_path, _level, poped_db);
+			if (!this_cache->allocateNewTag(decoded, true))
+				throw std::runtime_error("ERR Alloc after Popping failed");
+			this->forwardClaim(_path, _level, _address);
+			if (leaves && this->inclusion == inclusion_t::inclusion_exclusive) {
+				this->forwardSwapDown(_path, _level + 1, poped_db);
+				return;
+			}
+			if (!leaves || !poped_db.first)
+				return;
+			_address = poped_db.second;//the dirty victim is written in the parent
+		}
+	}
 
 public:
 
@@ -240,163 +1303,642 @@ public:
 	}
 
 /**
- * con	[cache_count]	[block_size]	[policy_num]	-
- * Set Configurations
- * Perform Format Check for Policy Number
- * Mark Cache Count, Block Size, Policy Number as Ready
- * Warning: Policy number MUST be EITHER 1 OR 2
- * @param _cache_count Number of Cache Layers in this System
- * @param _block_size Number of Bytes that Each DataBlock can hold
- * @param _policy_num Policy Number this System should Implement
+ * con	[cache_count]	[block_size]	[policy_num]	-
+ * Set Configurations
+ * Perform Format Check for Policy Number
+ * Mark Cache Count, Block Size, Policy Number as Ready
+ * Warning: Policy number MUST be EITHER 1 OR 2
+ * @param _cache_count Number of Cache Layers in this System
+ * @param _block_size Number of Bytes that Each DataBlock can hold
+ * @param _policy_num Policy Number this System should Implement
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setConfig(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		uint32_t _cache_count = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _block_size = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		uint32_t _policy_num = narrowArgument<uint32_t>(std::get<2>(*_arguments));
+		if (ready.at(0) || ready.at(1) || ready.at(2) || ready.at(3))
+			throw std::invalid_argument("ERR con called twice");
+		if (_policy_num < 1 || _policy_num > 2)
+			throw std::runtime_error("ERR Policy Number Unrecognized");
+		else if (_policy_num == 1)
+			this->read_write_policy = POLICY_WBWA;
+		else if (_policy_num == 2)
+			this->read_write_policy = POLICY_WTNWA;
+		this->ready.at(0) = true;
+		this->cache_count = _cache_count;
+		if (_cache_count < 1)
+			throw std::runtime_error("ERR At Least 1 Cache is Needed");
+		this->ready.at(1) = true;
+		this->block_size = _block_size;
+		this->ready.at(2) = true;
+		this->buildHierarchy();//create every cache, top cache first
+		this->ready.at(3) = true;
+		this->ready.at(5) = true;
+		this->echo()
+				<< "con "
+				<< std::setw(10) << std::left << _cache_count
+				<< std::setw(10) << std::left << _block_size
+				<< std::setw(10) << std::left << _policy_num
+				<< std::endl;
+		this->configuration.emplace_back(&System::setConfig, *_arguments);
+		return true;
+	}
+
+/**
+ * scd	[cache_number]	[total_size]	[set_assoc]		-
+ * Set Cache Size and Set Assoc
+ * Perform Bound Checks for Cache Level
+ * Warning: Function will Mark Ready in Cache, not System
+ * @param _cache_level The level(index) of cache with lowest being 1
+ * @param _total_size Total Number of Bytes this Cache needs to Store
+ * @param _set_assoc Number of DataBlock for a Each Given Index
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setCacheDimension(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (!this->ready.at(3))
+			throw std::invalid_argument("ERR scd Called Before con");
+		uint32_t _cache_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _total_size = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		uint32_t _set_assoc = narrowArgument<uint32_t>(std::get<2>(*_arguments));
+		if (_cache_level > this->cache_count) return false;
+		if (block_size == 0) return false;
+		for (Cache *this_cache_ptr: this->getCacheCopies(_cache_level)) {
+			if (this_cache_ptr->operator bool())
+				throw std::invalid_argument("ERR scd called after inc");
+			this_cache_ptr->setParam(block_size, _total_size, _set_assoc);
+		}
+		this->echo()
+				<< "scd "
+				<< std::setw(10) << std::left << _cache_level
+				<< std::setw(10) << std::left << _total_size
+				<< std::setw(10) << std::left << _set_assoc
+				<< std::endl;
+		this->configuration.emplace_back(&System::setCacheDimension, *_arguments);
+		return true;
+	}
+
+
+/**
+ * scl	[cache_number]	[latency]						-
+ * Set Cache Latency
+ * Perform Bound Checks for Cache Level
+ * Warning: Function will Mark Ready in Cache, not System
+ * @param _cache_level The level(index) of cache with lowest being 1
+ * @param _latency Number of Clock Cycles to Complete Read for this Cache
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setCacheLatency(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		uint32_t _cache_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _latency = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		if (_cache_level > this->cache_count) return false;
+		for (Cache *this_cache: this->getCacheCopies(_cache_level)) {
+			if (this_cache->operator bool())
+				throw std::invalid_argument("ERR scl called after inc");
+			this_cache->setLatency(_latency);
+		}
+		this->echo()
+				<< "scl "
+				<< std::setw(10) << std::left << _cache_level
+				<< std::setw(10) << std::left << _latency
+				<< std::endl;
+		this->configuration.emplace_back(&System::setCacheLatency, *_arguments);
+		return true;
+	}
+
+/**
+ * srp	[cache_number]	[policy_num]					-
+ * Set Replacement Policy
+ * Perform Bound Checks for Cache Level
+ * Warning: Function will Mark Ready in Cache, not System. Caches never given srp use LRU
+ * @param _cache_level The level(index) of cache with lowest being 1
+ * @param _policy_num 1=LRU, 2=Tree-PLRU, 3=SRRIP, 4=BRRIP, 5=Random, 6=FIFO
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setReplacementPolicy(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		uint32_t _cache_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _policy_num = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		if (_cache_level > this->cache_count) return false;
+		if (_policy_num < 1 || _policy_num > 6)
+			throw std::runtime_error("ERR Replacement Policy Number Unrecognized");
+		for (Cache *this_cache: this->getCacheCopies(_cache_level)) {
+			if (this_cache->operator bool())
+				throw std::invalid_argument("ERR srp called after inc");
+			this_cache->setReplacementPolicy(static_cast<replacement_t>(_policy_num));
+		}
+		this->echo()
+				<< "srp "
+				<< std::setw(10) << std::left << _cache_level
+				<< std::setw(10) << std::left << _policy_num
+				<< std::endl;
+		this->configuration.emplace_back(&System::setReplacementPolicy, *_arguments);
+		return true;
+	}
+
+/**
+ * sml	[latency]										-
+ * Set Memory Latency
+ * Mark Memory Latency as Ready
+ * Warning: This Function does NOT Set Memory Latency in Cache Array
+ * @param _latency
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setMemoryLatency(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (!this->ready.at(3))
+			throw std::invalid_argument("ERR sml called after inc");
+		uint32_t _latency = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		this->memory_latency = _latency;
+		this->ready.at(4) = true;
+		this->echo()
+				<< "sml "
+				<< std::setw(10) << std::left << _latency
+				<< std::endl;
+		this->configuration.emplace_back(&System::setMemoryLatency, *_arguments);
+		return true;
+	}
+
+/**
+ * inc	[cache_number]									-
+ * Initialize Cache
+ * Perform Bound Checks for Cache Level
+ * @param _cache_level The level(index) of cache with lowest being 1
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool initCache(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+/*		if (!this->ready.at(4))
+			throw std::invalid_argument("ERR inc called before sml");*/
+		uint32_t _cache_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		if (_cache_level > this->cache_count) return false;
+		for (Cache *this_cache_ptr: this->getCacheCopies(_cache_level))
+			this_cache_ptr->initCacheArray();
+		this->echo()
+				<< "inc "
+				<< std::setw(10) << std::left << _cache_level
+				<< std::endl;
+		this->configuration.emplace_back(&System::initCache, *_arguments);
+		return true;
+	}
+
+/**
+ * lgv	[log_level]		[binary]						-
+ * Set Log Verbosity
+ * Warning: Levels above CACHESIM_LOG_MAX_LEVEL are compiled out and log nothing; levels above 1 (summary) are not
+ * available with par
+ * @param _log_level 0=Off, 1=Summary, 2=Per-Access, 3=Full Trace (default)
+ * @param _binary 0=Text log_system.lgs, 1=Binary log_system.lgb (print with --print-log)
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setLogLevel(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		uint32_t _log_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _binary = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		if (_log_level > 3 || _binary > 1)
+			throw std::runtime_error("ERR Log Level Unrecognized");
+		if (this->parallel_threads > 1 && _log_level > 1)
+			throw std::invalid_argument("ERR Log Levels above Summary Not Available with par");
+		event_log.setLevel(static_cast<log_level_t>(_log_level), _binary == 1);
+		this->echo()
+				<< "lgv "
+				<< std::setw(10) << std::left << _log_level
+				<< std::setw(10) << std::left << _binary
+				<< std::endl;
+		return true;
+	}
+
+/**
+ * stm	[window]										-
+ * Stream Tasks
+ * Run every task scheduled afterwards as soon as it leaves a reorder window of [window] tasks,
+ * instead of keeping the whole task queue until ins
+ * Warning: A task arriving earlier than one already run (out of order by more than the window) is an error
+ * @param _window Number of tasks held back for reordering, 0 if the trace is already in arrive-time order
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setStreaming(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (!this->ready.at(3))
+			throw std::invalid_argument("ERR stm Called Before con");
+		if (!this->task_queue.empty() || this->operator bool())
+			throw std::invalid_argument("ERR stm Called after Tasks were Scheduled");
+		if (this->parallel_threads > 1)
+			throw std::invalid_argument("ERR stm Called in Parallel Mode");
+		uint32_t _window = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		this->streaming = true;
+		this->stream_window = _window;
+		this->stream_heap.reserve(size_t{_window} + 1);
+		this->echo()
+				<< "stm "
+				<< std::setw(10) << std::left << _window
+				<< std::endl;
+		return true;
+	}
+
+/**
+ * cor	[core_count]	[private_levels]	[snoop_latency]
+ * Set Cores
+ * Give each of [core_count] cores its own copy of levels 1 to [private_levels]; lower levels are shared.
+ * scd/scl/srp/inc of a private level apply to every core's copy; tcr/tcw name the core of an access
+ * Warning: Private copies are kept coherent with MESI; a snoop that invalidates or fetches a dirty copy
+ * costs [snoop_latency] cycles on top of the write-back it causes
+ * @param _core_count Number of Cores, at least 2
+ * @param _private_levels Number of Levels Private to Each Core, 1 to the Number of Levels
+ * @param _snoop_latency Clock Cycles a Coherence Transaction Takes
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setCores(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (!this->ready.at(3))
+			throw std::invalid_argument("ERR cor Called Before con");
+		if (this->core_count > 1)
+			throw std::invalid_argument("ERR cor called twice");
+		if (this->getCacheAtPtr(1)->getSetCount() != 0)
+			throw std::invalid_argument("ERR cor called after scd");
+		uint32_t _core_count = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _private_levels = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		uint32_t _snoop_latency = narrowArgument<uint32_t>(std::get<2>(*_arguments));
+		if (_core_count < 2 || _core_count > UINT16_MAX)
+			throw std::invalid_argument("ERR Core Count Out-of-range");
+		if (_private_levels < 1 || _private_levels > this->cache_count)
+			throw std::invalid_argument("ERR Private Levels Out-of-range");
+		this->core_count = _core_count;
+		this->private_levels = _private_levels;
+		this->snoop_latency = _snoop_latency;
+		this->coherence_counts.resize(_core_count);
+		this->latency_histograms.resize(_core_count);
+		this->buildHierarchy();//nothing is configured yet, so every core's caches are simply created anew
+		this->echo()
+				<< "cor "
+				<< std::setw(10) << std::left << _core_count
+				<< std::setw(10) << std::left << _private_levels
+				<< std::setw(10) << std::left << _snoop_latency
+				<< std::endl;
+		this->configuration.emplace_back(&System::setCores, *_arguments);
+		return true;
+	}
+
+/**
+ * par	[threads]										-
+ * Run in Parallel
+ * Split the sets into up to [threads] shards simulated concurrently when ins runs; hits, misses and clock cycles
+ * are the same as a serial run (see runTaskQueueParallel)
+ * Warning: pci, sck, lck, streaming, and event log levels above 1 (summary) are not available in parallel; the
+ * default level is lowered to summary
+ * @param _threads Number of Threads, 0 for one per hardware thread, 1 to run serially
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setParallel(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool() || this->streaming)
+			throw std::invalid_argument("ERR par called after ins or with stm");
+		if (this->prefetching)
+			throw std::invalid_argument("ERR par Not Available with Prefetchers");
+		if (this->non_blocking)
+			throw std::invalid_argument("ERR par Not Available with Non-Blocking Caches");
+		if (this->victim_caching)
+			throw std::invalid_argument("ERR par Not Available with Victim Caches");
+		if (this->checkpointing || !this->restore_filename.empty())
+			throw std::invalid_argument("ERR par Not Available with Checkpoints");
+		if (this->forward_accesses != 0)
+			throw std::invalid_argument("ERR par Not Available with ffw by Access Count");
+		if (this->interval_stats.isEnabled())
+			throw std::invalid_argument("ERR par Not Available with Interval Stats");
+		if (this->event_log.isChosenAbove(log_level_t::log_summary))
+			throw std::invalid_argument("ERR par Not Available with Log Levels above Summary");
+		uint32_t _threads = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		this->parallel_threads = _threads != 0 ? _threads : std::max(1U, std::thread::hardware_concurrency());
+		this->echo()
+				<< "par "
+				<< std::setw(10) << std::left << _threads
+				<< std::endl;
+		return true;
+	}
+
+/**
+ * spf	[cache_level]	[prefetcher]	[degree]
+ * Set Prefetcher
+ * Prefetch into a cache level on demand accesses; pcr reports of the level add the prefetch counters
+ * Warning: Not available with par or sss, nor on private levels of several cores (prefetches do not snoop)
+ * @param _cache_level The level(index) of cache with lowest being 1
+ * @param _prefetcher 0=Off, 1=Next-Line, 2=Stride, 3=Stream Buffer
+ * @param _degree Blocks prefetched ahead of the demand (the depth of a stream buffer)
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setPrefetcher(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool() || this->last_streamed_task != nullptr)
+			throw std::invalid_argument("ERR spf called after System Started");
+		uint32_t _cache_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _prefetcher = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		uint32_t _degree = narrowArgument<uint32_t>(std::get<2>(*_arguments));
+		if (_prefetcher > 3)
+			throw std::runtime_error("ERR Prefetcher Unrecognized");
+		if (this->parallel_threads > 1 || this->set_sampler.isEnabled())
+			throw std::invalid_argument("ERR spf Not Available with par or sss");
+		if (this->core_count > 1 && _cache_level <= this->private_levels)
+			throw std::invalid_argument("ERR spf Not Available on Private Levels");
+		if (this->inclusion != inclusion_t::inclusion_nine)
+			throw std::invalid_argument("ERR spf Not Available with Inclusive or Exclusive Hierarchies");
+		for (Cache *this_cache: this->getCacheCopies(_cache_level)) {
+			if (this_cache->getSetCount() == 0)
+				throw std::invalid_argument("ERR spf Called Before scd");
+			this_cache->getPrefetcher().configure(static_cast<prefetcher_t>(_prefetcher), _degree,
+												 this_cache->getDecoder().getOffsetBits());
+		}
+		this->prefetching |= _prefetcher != 0;
+		this->echo()
+				<< "spf "
+				<< std::setw(10) << std::left << _cache_level
+				<< std::setw(10) << std::left << _prefetcher
+				<< std::setw(10) << std::left << _degree
+				<< std::endl;
+		this->configuration.emplace_back(&System::setPrefetcher, *_arguments);
+		return true;
+	}
+
+/**
+ * sip	[policy]		-								-
+ * Set Inclusion Policy
+ * Choose how the content of each level relates to the levels above it in a core's path; pcr reports of an
+ * inclusive hierarchy add the blocks each level's evictions invalidated above
+ * Warning: Not available with spf
+ * @param _policy 0=Non-Inclusive Non-Exclusive, 1=Inclusive, 2=Exclusive
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setInclusion(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool() || this->last_streamed_task != nullptr)
+			throw std::invalid_argument("ERR sip called after System Started");
+		uint32_t _policy = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		if (_policy > 2)
+			throw std::runtime_error("ERR Inclusion Policy Unrecognized");
+		if (_policy != 0 && this->prefetching)
+			throw std::invalid_argument("ERR sip Not Available with Prefetchers");
+		this->inclusion = static_cast<inclusion_t>(_policy);
+		this->echo()
+				<< "sip "
+				<< std::setw(10) << std::left << _policy
+				<< std::endl;
+		this->configuration.emplace_back(&System::setInclusion, *_arguments);
+		return true;
+	}
+
+/**
+ * svc	[cache_level]	[entries]						-
+ * Set Victim Cache
+ * Attach a small fully-associative buffer to a cache level holding the blocks it evicts; a miss of the level
+ * finding its block there takes it back at the level's latency. Snoops and back-invalidations reach its blocks too.
+ * pcr reports of the level add its counters
+ * Warning: Not available with par or sss
+ * @param _cache_level The level(index) of cache with lowest being 1
+ * @param _entries Blocks the victim cache holds
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setVictimCache(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool() || this->last_streamed_task != nullptr)
+			throw std::invalid_argument("ERR svc called after System Started");
+		uint32_t _cache_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _entries = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		if (this->parallel_threads > 1 || this->set_sampler.isEnabled())
+			throw std::invalid_argument("ERR svc Not Available with par or sss");
+		for (Cache *this_cache: this->getCacheCopies(_cache_level)) {
+			if (this_cache->getSetCount() == 0)
+				throw std::invalid_argument("ERR svc Called Before scd");
+			this_cache->getVictimCache().configure(_entries, this_cache->getDecoder().getOffsetBits());
+		}
+		this->victim_caching = true;
+		this->echo()
+				<< "svc "
+				<< std::setw(10) << std::left << _cache_level
+				<< std::setw(10) << std::left << _entries
+				<< std::endl;
+		this->configuration.emplace_back(&System::setVictimCache, *_arguments);
+		return true;
+	}
+
+/**
+ * mhr	[cache_level]	[mshr_count]					-
+ * Set Miss Status Holding Registers
+ * Make the caches non-blocking: accesses issue at their arrive time and overlap, up to [mshr_count] outstanding
+ * read misses at this level (one at levels without mhr); misses to a block already being filled merge into it.
+ * pcr reports add the register counters of every level
+ * Warning: Not available with par
+ * @param _cache_level The level(index) of cache with lowest being 1
+ * @param _mshr_count Outstanding misses the level can hold
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setMshrs(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool() || this->last_streamed_task != nullptr)
+			throw std::invalid_argument("ERR mhr called after System Started");
+		uint32_t _cache_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _mshr_count = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		if (this->parallel_threads > 1)
+			throw std::invalid_argument("ERR mhr Not Available with par");
+		for (Cache *this_cache: this->getCacheCopies(_cache_level)) {
+			if (this_cache->getSetCount() == 0)
+				throw std::invalid_argument("ERR mhr Called Before scd");
+			this_cache->getMshrFile().configure(_mshr_count);
+		}
+		this->non_blocking = true;
+		this->echo()
+				<< "mhr "
+				<< std::setw(10) << std::left << _cache_level
+				<< std::setw(10) << std::left << _mshr_count
+				<< std::endl;
+		this->configuration.emplace_back(&System::setMshrs, *_arguments);
+		return true;
+	}
+
+/**
+ * sss	[method]		[ratio]							-
+ * Sample Sets
+ * Simulate only one in [ratio] sets of every level; accesses to other sets are dropped as soon as decoded.
+ * Sets are chosen among the index bits all levels share, so a sampled set's fills and write-backs stay sampled
+ * Warning: Timing only covers the sampled accesses; pcr reports add the 95% interval of the miss rate
+ * @param _method 0=Off, 1=Every Nth Set, 2=Hashed
+ * @param _ratio Keep one in [ratio] sets
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setSampling(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool() || this->last_streamed_task != nullptr)
+			throw std::invalid_argument("ERR sss called after System Started");
+		uint32_t _method = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _ratio = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		if (_method > 2)
+			throw std::runtime_error("ERR Sampling Method Unrecognized");
+		if (_method != 0 && this->prefetching)
+			throw std::invalid_argument("ERR sss Not Available with Prefetchers");
+		if (_method != 0 && this->victim_caching)
+			throw std::invalid_argument("ERR sss Not Available with Victim Caches");
+		set_sampler.setMethod(static_cast<sampling_t>(_method), _ratio);
+		this->echo()
+				<< "sss "
+				<< std::setw(10) << std::left << _method
+				<< std::setw(10) << std::left << _ratio
+				<< std::endl;
+		this->configuration.emplace_back(&System::setSampling, *_arguments);
+		return true;
+	}
+
+/**
+ * lck	[checkpoint_id]	-								-
+ * Load Checkpoint
+ * Restore the caches, clock and coherence counters saved by sck into ckp_[checkpoint_id].ckp right before the first
+ * task runs, instead of starting from empty caches. The checkpoint is memory-mapped
+ * Warning: The hierarchy must be configured as when it was saved (latencies may differ). Not available with par
+ * @param _checkpoint_id Checkpoint to be Restored
  * @return True if Instruction Ran without Errors, false otherwise
  */
-	bool setConfig(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool loadCheckpoint(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
-		uint32_t _cache_count = std::get<0>(*_arguments);
-		uint32_t _block_size = std::get<1>(*_arguments);
-		uint32_t _policy_num = std::get<2>(*_arguments);
-		if (ready.at(0) || ready.at(1) || ready.at(2) || ready.at(3))
-			throw std::invalid_argument("ERR con called twice");
-		if (_policy_num < 1 || _policy_num > 2)
-			throw std::runtime_error("ERR Policy Number Unrecognized");
-		else if (_policy_num == 1)
-			this->read_write_policy = POLICY_WBWA;
-		else if (_policy_num == 2)
-			this->read_write_policy = POLICY_WTNWA;
-		this->ready.at(0) = true;
-		this->cache_count = _cache_count;
-		if (_cache_count < 1)
-			throw std::runtime_error("ERR At Least 1 Cache is Needed");
-		this->ready.at(1) = true;
-		this->block_size = _block_size;
-		this->ready.at(2) = true;
-		this->top_cache_ptr = std::make_unique<Cache>();//create childest cache
-		Cache *this_cache_ptr = top_cache_ptr.get();//cache pointer iterator
-		if (this_cache_ptr->operator bool())
-			throw std::invalid_argument("ERR con Called after inc");
-		this_cache_ptr->setId(1);
-		if (cache_count == 1) this_cache_ptr->makeAsTopCache();
-		for (size_t i = 2; i <= _cache_count; i++) {
-			this_cache_ptr->makeParent();
-			this_cache_ptr = this_cache_ptr->getParentPtr();
-			this_cache_ptr->setId(i);
-		}
-		this->ready.at(3) = true;
-		this->report_writer.first.open("log_system.lgs");
-		this->ready.at(5) = true;
-		std::cout
-				<< "con "
-				<< std::setw(10) << std::left << _cache_count
-				<< std::setw(10) << std::left << _block_size
-				<< std::setw(10) << std::left << _policy_num
+		if (this->operator bool() || this->last_streamed_task != nullptr)
+			throw std::invalid_argument("ERR lck called after System Started");
+		if (this->parallel_threads > 1)
+			throw std::invalid_argument("ERR lck Not Available with par");
+		address_t _checkpoint_id = std::get<0>(*_arguments);
+		if (!std::ifstream{checkpointName(_checkpoint_id)}.is_open())
+			throw std::runtime_error("ERR Checkpoint NOT Found.");
+		this->restore_filename = checkpointName(_checkpoint_id);
+		this->echo()
+				<< "lck "
+				<< std::setw(10) << std::left << _checkpoint_id
 				<< std::endl;
 		return true;
 	}
 
 /**
- * scd	[cache_number]	[total_size]	[set_assoc]		-
- * Set Cache Size and Set Assoc
- * Perform Bound Checks for Cache Level
- * Warning: Function will Mark Ready in Cache, not System
- * @param _cache_level The level(index) of cache with lowest being 1
- * @param _total_size Total Number of Bytes this Cache needs to Store
- * @param _set_assoc Number of DataBlock for a Each Given Index
+ * ffw	[accesses]		[arr_time]						-
+ * Fast-Forward Functionally
+ * Run accesses functionally until [accesses] accesses have run or a task arrives at [arr_time], whichever comes
+ * first (0 for no such bound): they only update cache contents and replacement state, without clock cycles, event
+ * log or reports (sck still saves). The detailed run that follows starts with every counter cleared
+ * Warning: par only takes an [arr_time] bound
+ * @param _accesses Accesses to Fast-Forward over, 0 for No Bound
+ * @param _arrive_time Arrive Time the Detailed Run Starts at, 0 for No Bound
  * @return True if Instruction Ran without Errors, false otherwise
  */
-	bool setCacheDimension(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool setFastForward(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
-		if (!this->ready.at(3))
-			throw std::invalid_argument("ERR scd Called Before con");
-		uint32_t _cache_level = std::get<0>(*_arguments);
-		uint32_t _total_size = std::get<1>(*_arguments);
-		uint32_t _set_assoc = std::get<2>(*_arguments);
-		if (_cache_level > this->cache_count) return false;
-		if (block_size == 0) return false;
-		Cache *this_cache_ptr = getCacheAtPtr(_cache_level);
-		if (this_cache_ptr->operator bool())
-			throw std::invalid_argument("ERR scd called after inc");
-		this_cache_ptr->setParam(block_size, _total_size, _set_assoc);
-		std::cout
-				<< "scd "
-				<< std::setw(10) << std::left << _cache_level
-				<< std::setw(10) << std::left << _total_size
-				<< std::setw(10) << std::left << _set_assoc
+		if (this->operator bool() || this->last_streamed_task != nullptr)
+			throw std::invalid_argument("ERR ffw called after System Started");
+		uint64_t _accesses = std::get<0>(*_arguments);
+		uint64_t _arrive_time = std::get<1>(*_arguments);
+		if (this->parallel_threads > 1 && _accesses != 0)
+			throw std::invalid_argument("ERR ffw by Access Count Not Available with par");
+		this->forward_accesses = _accesses;
+		this->forward_time = _arrive_time;
+		this->fast_forwarding = _accesses != 0 || _arrive_time != 0;
+		this->echo()
+				<< "ffw "
+				<< std::setw(10) << std::left << _accesses
+				<< std::setw(10) << std::left << _arrive_time
 				<< std::endl;
+		this->configuration.emplace_back(&System::setFastForward, *_arguments);
 		return true;
 	}
 
-
 /**
- * scl	[cache_number]	[latency]						-
- * Set Cache Latency
- * Perform Bound Checks for Cache Level
- * Warning: Function will Mark Ready in Cache, not System
- * @param _cache_level The level(index) of cache with lowest being 1
- * @param _latency Number of Clock Cycles to Complete Read for this Cache
+ * sis	[unit]			[interval]		[binary]
+ * Set Interval Statistics
+ * Append every level's hits, misses, evictions and write-backs, and the accesses and their summed latency, to one
+ * file per [interval] accesses or clock cycles of the detailed run, instead of a report file per pcr/pci task
+ * Warning: Not available with par
+ * @param _unit 0=Off, 1=Accesses, 2=Clock Cycles
+ * @param _interval Accesses or clock cycles per interval
+ * @param _binary 0=Text (stats_system.csv), 1=Binary (stats_system.stb)
  * @return True if Instruction Ran without Errors, false otherwise
  */
-	bool setCacheLatency(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool setIntervalStats(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
-		uint32_t _cache_level = std::get<0>(*_arguments);
-		uint32_t _latency = std::get<1>(*_arguments);
-		if (_cache_level > this->cache_count) return false;
-		Cache *this_cache = this->getCacheAtPtr(_cache_level);
-		if (this_cache->operator bool())
-			throw std::invalid_argument("ERR scl called after inc");
-		this_cache->setLatency(_latency);
-		std::cout
-				<< "scl "
-				<< std::setw(10) << std::left << _cache_level
-				<< std::setw(10) << std::left << _latency
+		if (this->operator bool() || this->last_streamed_task != nullptr)
+			throw std::invalid_argument("ERR sis called after System Started");
+		if (this->parallel_threads > 1)
+			throw std::invalid_argument("ERR sis Not Available with par");
+		uint32_t _unit = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _interval = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		uint32_t _binary = narrowArgument<uint32_t>(std::get<2>(*_arguments));
+		if (_unit > 2 || _binary > 1)
+			throw std::invalid_argument("ERR Interval Stats Unit Unrecognized");
+		interval_stats.configure(static_cast<interval_t>(_unit), _interval, _binary == 1);
+		this->echo()
+				<< "sis "
+				<< std::setw(10) << std::left << _unit
+				<< std::setw(10) << std::left << _interval
+				<< std::setw(10) << std::left << _binary
 				<< std::endl;
 		return true;
 	}
 
 /**
- * sml	[latency]										-
- * Set Memory Latency
- * Mark Memory Latency as Ready
- * Warning: This Function does NOT Set Memory Latency in Cache Array
- * @param _latency
+ * sim	[delta]											-
+ * Set Image Mode
+ * With delta images, pci writes only the sets of the level changed since its previous pci (the first one writes
+ * every set), to dlt_l<id>_<time>.csv instead of img_l<id>_<time>.csv; --rebuild-image turns them back into full images
+ * @param _delta 0=Full Images, 1=Delta Images
  * @return True if Instruction Ran without Errors, false otherwise
  */
-	bool setMemoryLatency(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool setImageMode(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
-		if (!this->ready.at(3))
-			throw std::invalid_argument("ERR sml called after inc");
-		uint32_t _latency = std::get<0>(*_arguments);
-		this->memory_latency = _latency;
-		this->ready.at(4) = true;
-		std::cout
-				<< "sml "
-				<< std::setw(10) << std::left << _latency
+		if (this->operator bool() || this->last_streamed_task != nullptr)
+			throw std::invalid_argument("ERR sim called after System Started");
+		uint32_t _delta = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		if (_delta > 1)
+			throw std::invalid_argument("ERR Image Mode Unrecognized");
+		this->delta_images = _delta == 1;
+		this->echo()
+				<< "sim "
+				<< std::setw(10) << std::left << _delta
 				<< std::endl;
 		return true;
 	}
 
 /**
- * inc	[cache_number]									-
- * Initialize Cache
- * Perform Bound Checks for Cache Level
- * @param _cache_level The level(index) of cache with lowest being 1
+ * sce	[export]										-
+ * Set Counter Export
+ * When the run ends, write the counters of every cache to cnt_system.csv and the latency histogram of every core
+ * to lat_system.csv, as pcs and plh would
+ * @param _export 0=Off, 1=On
  * @return True if Instruction Ran without Errors, false otherwise
  */
-	bool initCache(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool setCountExport(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
-/*		if (!this->ready.at(4))
-			throw std::invalid_argument("ERR inc called before sml");*/
-		uint32_t _cache_level = std::get<0>(*_arguments);
-		if (_cache_level > this->cache_count) return false;
-		Cache *this_cache_ptr = this->getCacheAtPtr(_cache_level);
-		this_cache_ptr->initCacheArray();
-		std::cout
-				<< "inc "
-				<< std::setw(10) << std::left << _cache_level
+		if (this->operator bool() || this->last_streamed_task != nullptr)
+			throw std::invalid_argument("ERR sce called after System Started");
+		uint32_t _export = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		if (_export > 1)
+			throw std::invalid_argument("ERR Counter Export Unrecognized");
+		this->export_counts = _export == 1;
+		this->echo()
+				<< "sce "
+				<< std::setw(10) << std::left << _export
 				<< std::endl;
 		return true;
 	}
@@ -404,19 +1946,19 @@ public:
 /**
  * tre	[address]		[arr_time]						-
  * Task Read Address at Time
- * @param _address Raw 32-bit Address to be Read
+ * @param _address Raw Address to be Read
  * @param _arrive_time	Clock Cycle at when This Specific Task is Scheduled
  * @return True if Instruction Ran without Errors, false otherwise
  */
-	bool taskReadAddress(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool taskReadAddress(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
 		if (this->operator bool())
 			throw std::invalid_argument("ERR Cannot Task Once System is Initialized");
-		uint32_t _address = std::get<0>(*_arguments);
-		uint32_t _arrive_time = std::get<1>(*_arguments);
-		this->task_queue.emplace_back(task_t::task_readAddress, _address, _arrive_time);
-		std::cout
+		address_t _address = std::get<0>(*_arguments);
+		uint64_t _arrive_time = std::get<1>(*_arguments);
+		this->scheduleTask(Task{task_t::task_readAddress, _address, _arrive_time});
+		this->echo()
 				<< "tre "
 				<< std::setw(10) << std::left << _address
 				<< std::setw(10) << std::left << _arrive_time
@@ -427,19 +1969,19 @@ public:
 /**
  * twr	[address]		[arr_time]						-
  * Task Write Address at Time
- * @param _address Raw 32-bit Address to be Written
+ * @param _address Raw Address to be Written
  * @param _arrive_time Clock Cycle at when This Specific Task is Scheduled
  * @return True if Instruction Ran without Errors, false otherwise
  */
-	bool taskWriteAddress(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool taskWriteAddress(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
 		if (this->operator bool())
 			throw std::invalid_argument("ERR Cannot Task Once System is Initialized");
-		uint32_t _address = std::get<0>(*_arguments);
-		uint32_t _arrive_time = std::get<1>(*_arguments);
-		this->task_queue.emplace_back(task_t::task_writeAddress, _address, _arrive_time);
-		std::cout
+		address_t _address = std::get<0>(*_arguments);
+		uint64_t _arrive_time = std::get<1>(*_arguments);
+		this->scheduleTask(Task{task_t::task_writeAddress, _address, _arrive_time});
+		this->echo()
 				<< "twr "
 				<< std::setw(10) << std::left << _address
 				<< std::setw(10) << std::left << _arrive_time
@@ -447,20 +1989,231 @@ public:
 		return true;
 	}
 
+/**
+ * tcr	[address]		[arr_time]		[core_id]
+ * Task Read Address at Time from a Core
+ * @param _address Raw Address to be Read
+ * @param _arrive_time	Clock Cycle at when This Specific Task is Scheduled
+ * @param _core_id Core Issuing the Read, 0 to core_count - 1
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskCoreReadAddress(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool())
+			throw std::invalid_argument("ERR Cannot Task Once System is Initialized");
+		address_t _address = std::get<0>(*_arguments);
+		uint64_t _arrive_time = std::get<1>(*_arguments);
+		uint32_t _core_id = narrowArgument<uint32_t>(std::get<2>(*_arguments));
+		if (_core_id >= this->core_count)
+			throw std::out_of_range("ERR Core ID Out-of-range");
+		this->scheduleTask(Task{task_t::task_readAddress, _address, _arrive_time, static_cast<uint16_t>(_core_id)});
+		this->echo()
+				<< "tcr "
+				<< std::setw(10) << std::left << _address
+				<< std::setw(10) << std::left << _arrive_time
+				<< std::setw(10) << std::left << _core_id
+				<< std::endl;
+		return true;
+	}
+
+/**
+ * tcw	[address]		[arr_time]		[core_id]
+ * Task Write Address at Time from a Core
+ * @param _address Raw Address to be Written
+ * @param _arrive_time Clock Cycle at when This Specific Task is Scheduled
+ * @param _core_id Core Issuing the Write, 0 to core_count - 1
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskCoreWriteAddress(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool())
+			throw std::invalid_argument("ERR Cannot Task Once System is Initialized");
+		address_t _address = std::get<0>(*_arguments);
+		uint64_t _arrive_time = std::get<1>(*_arguments);
+		uint32_t _core_id = narrowArgument<uint32_t>(std::get<2>(*_arguments));
+		if (_core_id >= this->core_count)
+			throw std::out_of_range("ERR Core ID Out-of-range");
+		this->scheduleTask(Task{task_t::task_writeAddress, _address, _arrive_time, static_cast<uint16_t>(_core_id)});
+		this->echo()
+				<< "tcw "
+				<< std::setw(10) << std::left << _address
+				<< std::setw(10) << std::left << _arrive_time
+				<< std::setw(10) << std::left << _core_id
+				<< std::endl;
+		return true;
+	}
+
+/**
+ * gcf	[seed]			[write_percent]	[base_address]
+ * Configure Generators
+ * Reseed the generator shared by gsq/gru/gzf/gpc/gpt and set the write mix and the start of their footprint
+ * @param _seed Seed of the generator (default 1)
+ * @param _write_percent Percent of generated accesses that are writes (default 0)
+ * @param _base_address Raw address the footprint of later streams starts at (default 0)
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool setGenerator(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		uint32_t _seed = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint32_t _write_percent = narrowArgument<uint32_t>(std::get<1>(*_arguments));
+		address_t _base_address = std::get<2>(*_arguments);
+		this->access_generator.configure(_seed, _write_percent, _base_address);
+		this->echo()
+				<< "gcf "
+				<< std::setw(10) << std::left << _seed
+				<< std::setw(10) << std::left << _write_percent
+				<< std::setw(10) << std::left << _base_address
+				<< std::endl;
+		return true;
+	}
+
+/**
+ * Schedule a Generated Access Stream, One Access per Clock Cycle after the Latest Task Scheduled so Far
+ * Accesses are issued by core 0; consumer accesses of gpc by core 1 when there are several cores
+ * @param _kind Kind of the stream
+ * @param _name Instruction echoed
+ * @param _arguments [count][footprint][parameter], see AccessGenerator::generate
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskGenerate(const generator_t &_kind, const std::string &_name,
+					  std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool())
+			throw std::invalid_argument("ERR Cannot Task Once System is Initialized");
+		if (!this->ready.at(2))
+			throw std::invalid_argument("ERR " + _name + " Called Before con");
+		uint32_t _count = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		address_t _footprint = std::get<1>(*_arguments);
+		uint32_t _parameter = narrowArgument<uint32_t>(std::get<2>(*_arguments));
+		const uint16_t consumer_core = this->core_count > 1 ? 1 : 0;
+		this->echo()
+				<< _name << " "
+				<< std::setw(10) << std::left << _count
+				<< std::setw(10) << std::left << _footprint
+				<< std::setw(10) << std::left << _parameter
+				<< std::endl;
+		uint64_t arrive_time = this->latest_arrive_time;
+		this->access_generator.generate(_kind, _count, _footprint, _parameter, this->block_size,
+										[this, &arrive_time, &consumer_core](const task_t &_task_type,
+																			  const address_t &_address,
+																			  const bool &_consumer) {
+											this->scheduleTask(Task{_task_type, _address, ++arrive_time,
+																	_consumer ? consumer_core : uint16_t{0}});
+										});
+		return true;
+	}
+
+/**
+ * gsq	[count]			[footprint]		[stride]
+ * Generate a Sequential Stream
+ * Addresses step by [stride] bytes from the base address, wrapping around within the footprint
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskGenerateSequential(std::tuple<address_t, address_t, address_t> *_arguments) {
+		return this->taskGenerate(generator_t::generate_sequential, "gsq", _arguments);
+	}
+
+/**
+ * gru	[count]			[footprint]		-
+ * Generate a Uniform Random Stream
+ * Every byte address of the footprint is equally likely
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskGenerateRandom(std::tuple<address_t, address_t, address_t> *_arguments) {
+		return this->taskGenerate(generator_t::generate_random, "gru", _arguments);
+	}
+
+/**
+ * gzf	[count]			[footprint]		[theta]
+ * Generate a Zipfian Hot-Set Stream
+ * Blocks of the footprint are ranked in a random order; rank r is accessed with probability proportional to
+ * 1 / (r + 1)^(theta / 100)
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskGenerateZipf(std::tuple<address_t, address_t, address_t> *_arguments) {
+		return this->taskGenerate(generator_t::generate_zipf, "gzf", _arguments);
+	}
+
+/**
+ * gpc	[count]			[footprint]		[lag]
+ * Generate a Producer/Consumer Stream
+ * A producer writes the blocks of the footprint in turn as a ring buffer; after each write a consumer reads the
+ * block written [lag] blocks earlier
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskGenerateProducerConsumer(std::tuple<address_t, address_t, address_t> *_arguments) {
+		return this->taskGenerate(generator_t::generate_producer_consumer, "gpc", _arguments);
+	}
+
+/**
+ * gpt	[count]			[footprint]		-
+ * Generate a Pointer-Chase Stream
+ * Blocks of the footprint are linked in one random cycle, which the stream follows from the first block
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskGeneratePointerChase(std::tuple<address_t, address_t, address_t> *_arguments) {
+		return this->taskGenerate(generator_t::generate_pointer_chase, "gpt", _arguments);
+	}
+
+/**
+ * Schedule Every Record of a Binary Trace into the Task Queue
+ * Records become Tasks straight from the mapping, without the per-task echo of tre/twr
+ * Report records for cache levels out of range are dropped, as pcr/pci drop them
+ * @param _trace Memory-mapped binary trace
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskTrace(const TraceReader &_trace) {
+		if (this->operator bool())
+			throw std::invalid_argument("ERR Cannot Task Once System is Initialized");
+		if (!this->streaming)
+			this->task_queue.reserve(this->task_queue.size() + _trace.size());
+		for (const TraceRecord &this_record: _trace) {
+			task_t this_task = this_record.getTaskType();
+			if ((this_task == task_t::task_reportHitMiss || this_task == task_t::task_reportImage ||
+				 this_task == task_t::task_reportCounts) && this_record.getValue() > this->cache_count)
+				continue;
+			if ((this_task == task_t::task_reportCoherence || this_task == task_t::task_reportLatency) &&
+				this_record.getValue() >= this->core_count)
+				continue;
+			this->scheduleTask(this_record.toTask());
+		}
+		this->echo()
+				<< "trc "
+				<< std::setw(10) << std::left << _trace.size()
+				<< std::endl;
+		return true;
+	}
+
 /**
  * ins													-
  * Initialize System
  * @return True if Instruction Ran without Errors, false otherwise
  */
-	bool initSystem(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool initSystem(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
-		sortTaskQueue();
-		this->ready.at(6) = true;
-		if (!this->operator bool())
-			throw std::runtime_error("ERR System Cannot Initialize - System Not Ready");
-		runTaskQueue();
-		std::cout
+		if (this->streaming) {//drain the reorder window, every other task has already run
+			while (!this->stream_heap.empty())
+				this->runStreamedTask();
+			this->ready.at(6) = true;
+			this->finishRun();
+		} else {
+			sortTaskQueue();
+			this->ready.at(6) = true;
+			if (!this->operator bool())
+				throw std::runtime_error("ERR System Cannot Initialize - System Not Ready");
+			this->startRun();
+			if (this->parallel_threads > 1)
+				runTaskQueueParallel();
+			else
+				runTaskQueue();
+			this->finishRun();
+		}
+		this->echo()
 				<< "ins "
 				<< std::endl;
 		return true;
@@ -473,16 +2226,16 @@ public:
  * @param _cache_level The level(index) of cache with lowest being 1
  * @return True if Instruction Ran without Errors, false otherwise
  */
-	bool taskPrintCacheRate(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool taskPrintCacheRate(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
 		if (this->operator bool())
 			throw std::invalid_argument("ERR Cannot Report Once System is Initialized");
-		uint32_t _cache_level = std::get<0>(*_arguments);
-		uint32_t _arrive_time = std::get<1>(*_arguments);
+		uint32_t _cache_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint64_t _arrive_time = std::get<1>(*_arguments);
 		if (_cache_level > this->cache_count) return false;
-		this->task_queue.emplace_back(task_t::task_reportHitMiss, _cache_level, _arrive_time);
-		std::cout
+		this->scheduleTask(Task{task_t::task_reportHitMiss, _cache_level, _arrive_time});
+		this->echo()
 				<< "pcr "
 				<< std::setw(10) << std::left << _cache_level
 				<< std::setw(10) << std::left << _arrive_time
@@ -497,16 +2250,16 @@ public:
  * @param _cache_level The level(index) of cache with lowest being 1
  * @return True if Instruction Ran without Errors, false otherwise
  */
-	bool taskPrintCacheImage(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool taskPrintCacheImage(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
 		if (this->operator bool())
 			throw std::invalid_argument("ERR Cannot Report Once System is Initialized");
-		uint32_t _cache_level = std::get<0>(*_arguments);
-		uint32_t _arrive_time = std::get<1>(*_arguments);
+		uint32_t _cache_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint64_t _arrive_time = std::get<1>(*_arguments);
 		if (_cache_level > this->cache_count) return false;
-		this->task_queue.emplace_back(task_t::task_reportImage, _cache_level, _arrive_time);
-		std::cout
+		this->scheduleTask(Task{task_t::task_reportImage, _cache_level, _arrive_time});
+		this->echo()
 				<< "pci "
 				<< std::setw(10) << std::left << _cache_level
 				<< std::setw(10) << std::left << _arrive_time
@@ -514,44 +2267,267 @@ public:
 		return true;
 	}
 
+/**
+ * pcc	[core_id]		[arr_time]						-
+ * Print Cache Coherence Traffic of a Core
+ * @param _core_id Core to Report, 0 to core_count - 1
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskPrintCoherence(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool())
+			throw std::invalid_argument("ERR Cannot Report Once System is Initialized");
+		uint32_t _core_id = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint64_t _arrive_time = std::get<1>(*_arguments);
+		if (_core_id >= this->core_count) return false;
+		this->scheduleTask(Task{task_t::task_reportCoherence, _core_id, _arrive_time});
+		this->echo()
+				<< "pcc "
+				<< std::setw(10) << std::left << _core_id
+				<< std::setw(10) << std::left << _arrive_time
+				<< std::endl;
+		return true;
+	}
+
+/**
+ * pcs	[cache_number]	[arr_time]						-
+ * Print Cache Statistics
+ * Write the counters of the access path of a level (one file per core for a private level)
+ * @param _cache_level The level(index) of cache with lowest being 1
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskPrintCounts(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool())
+			throw std::invalid_argument("ERR Cannot Report Once System is Initialized");
+		uint32_t _cache_level = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint64_t _arrive_time = std::get<1>(*_arguments);
+		if (_cache_level > this->cache_count) return false;
+		this->scheduleTask(Task{task_t::task_reportCounts, _cache_level, _arrive_time});
+		this->echo()
+				<< "pcs "
+				<< std::setw(10) << std::left << _cache_level
+				<< std::setw(10) << std::left << _arrive_time
+				<< std::endl;
+		return true;
+	}
+
+/**
+ * plh	[core_id]		[arr_time]						-
+ * Print Latency Histogram of a Core
+ * @param _core_id Core to Report, 0 to core_count - 1
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskPrintLatency(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool())
+			throw std::invalid_argument("ERR Cannot Report Once System is Initialized");
+		uint32_t _core_id = narrowArgument<uint32_t>(std::get<0>(*_arguments));
+		uint64_t _arrive_time = std::get<1>(*_arguments);
+		if (_core_id >= this->core_count) return false;
+		this->scheduleTask(Task{task_t::task_reportLatency, _core_id, _arrive_time});
+		this->echo()
+				<< "plh "
+				<< std::setw(10) << std::left << _core_id
+				<< std::setw(10) << std::left << _arrive_time
+				<< std::endl;
+		return true;
+	}
+
+/**
+ * sck	[checkpoint_id]	[arr_time]						-
+ * Save Checkpoint
+ * Write the caches, clock, coherence counters and latency histograms to ckp_[checkpoint_id].ckp at the time,
+ * before the accesses arriving then (as reports), for later runs to restore with lck
+ * Warning: Not available with par
+ * @param _checkpoint_id Names the Checkpoint File
+ * @return True if Instruction Ran without Errors, false otherwise
+ */
+	bool taskSaveCheckpoint(std::tuple<address_t, address_t, address_t> *_arguments) {
+		if (_arguments == nullptr)
+			throw std::runtime_error("ERR Argument Tuple is NULL");
+		if (this->operator bool())
+			throw std::invalid_argument("ERR Cannot Save Checkpoint Once System is Initialized");
+		if (this->parallel_threads > 1)
+			throw std::invalid_argument("ERR sck Not Available with par");
+		address_t _checkpoint_id = std::get<0>(*_arguments);
+		uint64_t _arrive_time = std::get<1>(*_arguments);
+		this->checkpointing = true;
+		this->scheduleTask(Task{task_t::task_saveCheckpoint, _checkpoint_id, _arrive_time});
+		this->echo()
+				<< "sck "
+				<< std::setw(10) << std::left << _checkpoint_id
+				<< std::setw(10) << std::left << _arrive_time
+				<< std::endl;
+		return true;
+	}
+
 /**
  * hat
  * Stop Fetching Instruction
  * @return ALWAYS TRUE
  *//*
-	bool haltProgram(std::tuple<uint32_t, uint32_t, uint32_t> *_arguments) {
+	bool haltProgram(std::tuple<address_t, address_t, address_t> *_arguments) {
 		if (_arguments == nullptr)
 			throw std::runtime_error("ERR Argument Tuple is NULL");
-		uint32_t _arrive_time = std::get<0>(*_arguments);
+		uint64_t _arrive_time = std::get<0>(*_arguments);
 		task_queue.emplace_back(task_t::task_halt, 0, _arrive_time);
 		return false;
 	}*/
 
+	/**
+	 * Record a Completed Access in the Event Log, the Latency Histogram of its Core and the Interval Stats
+	 */
+	void accessCompleted(const oper_t &_oper, const address_t &_address, const uint64_t &_start_clock,
+						 const uint64_t &_finish_clock) {
+		event_log.access(_oper, _address, _start_clock, _finish_clock);
+		this->latency_histograms[this->current_core][latencyBucket(_finish_clock - _start_clock)]++;
+		interval_stats.closeBoundaries(this->access_start_counts, _finish_clock);
+		if (interval_stats.access(_finish_clock - _start_clock)) {
+			this->sampleLevelCounts(this->level_counts);
+			interval_stats.close(this->level_counts, clock_count);
+		}
+	}
+
+	/**
+	 * Run a Single Task at the Current Clock
+	 * The clock has already been advanced to the task's arrive time by the caller; with non-blocking caches an
+	 * access issues at its arrive time regardless, and the clock only moves on to when it completes
+	 * @param _task Task to be run
+	 * @return False if the task halts the system, true otherwise
+	 */
+	bool runTask(const Task &_task) {
+		task_t this_task = _task.getTaskType();
+		address_t this_value = _task.getTaskValue();
+		uint64_t this_arrive_time = _task.getArriveTime();
+		if (this_task == task_t::task_halt)
+			return false;
+		if (this->fast_forwarding) {
+			if ((this->forward_time != 0 && this_arrive_time >= this->forward_time) ||
+				(this->forward_accesses != 0 && this->forwarded_accesses == this->forward_accesses))
+				this->finishFastForward();
+			else {
+				if (this_task == task_t::task_readAddress || this_task == task_t::task_writeAddress) {
+					this->forwarded_accesses++;
+					if (!set_sampler.isEnabled() || set_sampler.isSampled(this_value))
+						this->forwardAccess(_task);
+				} else if (this_task == task_t::task_saveCheckpoint)
+					this->saveCheckpoint(this_value);
+				return true;//reports are dropped while fast-forwarding
+			}
+		}
+		if ((this_task == task_t::task_readAddress || this_task == task_t::task_writeAddress) &&
+			set_sampler.isEnabled() && !set_sampler.isSampled(this_value))
+			return true;//not in a sampled set, filtered before any level is probed
+		else if (this_task == task_t::task_reportHitMiss)
+			for (Cache *this_cache: this->getCacheCopies(this_value))
+				this_cache->printHitMissRate(this_arrive_time);
+		else if (this_task == task_t::task_reportImage && this->parallel_threads > 1)
+			throw std::runtime_error("ERR pci Not Available in Parallel Mode");
+		else if (this_task == task_t::task_reportImage && this->delta_images)
+			for (Cache *this_cache: this->getCacheCopies(this_value))
+				this_cache->printCacheDelta(this_arrive_time);
+		else if (this_task == task_t::task_reportImage)
+			for (Cache *this_cache: this->getCacheCopies(this_value))
+				this_cache->printCacheImage(this_arrive_time);
+		else if (this_task == task_t::task_reportCoherence)
+			this->printCoherence(this_value, this_arrive_time);
+		else if (this_task == task_t::task_reportCounts)
+			for (Cache *this_cache: this->getCacheCopies(this_value))
+				this_cache->printCounts(this_arrive_time);
+		else if (this_task == task_t::task_reportLatency)
+			this->printLatency(this_value, this_arrive_time);
+		else if (this_task == task_t::task_saveCheckpoint)
+			this->saveCheckpoint(this_value);
+		else if (this_task == task_t::task_readAddress) {
+			uint64_t start_clock = this->non_blocking ? this_arrive_time : clock_count;//non-blocking: issue on arrival
+			this->current_core = _task.getCoreId();
+			Cache *const *core_path = this->getCorePath(this->current_core);
+			this->coherence_counts[this->current_core].reads++;
+			if (interval_stats.isByCycles())
+				this->sampleLevelCounts(this->access_start_counts);
+			uint64_t finish_clock = this->readWalk(core_path, this_value, start_clock);
+			clock_count = std::max(clock_count, finish_clock);
+			this->accessCompleted(oper_t::oper_read, this_value, start_clock, finish_clock);
+		} else if (this_task == task_t::task_writeAddress) {
+			uint64_t start_clock = this->non_blocking ? this_arrive_time : clock_count;
+			this->current_core = _task.getCoreId();
+			Cache *const *core_path = this->getCorePath(this->current_core);
+			this->coherence_counts[this->current_core].writes++;
+			if (interval_stats.isByCycles())
+				this->sampleLevelCounts(this->access_start_counts);
+			uint64_t finish_clock{start_clock};
+			if (this->core_count > 1)//gain the only copy (Modified) before writing
+				finish_clock = this->snoopOtherCores(this_value, finish_clock, true);
+			finish_clock = this->writeWalk(core_path, 0, this_value, finish_clock);
+			clock_count = std::max(clock_count, finish_clock);
+			this->accessCompleted(oper_t::oper_write, this_value, start_clock, finish_clock);
+		}
+		return true;
+	}
+
+	/**
+	 * Run a Shared, Already Sorted List of Tasks without Copying it into the Task Queue
+	 * Used by sweeps, which feed the same tasks to many Systems; the log is forced off
+	 * @param _tasks Tasks in arrive-time order
+	 */
+	void runSortedTasks(const std::vector<Task> &_tasks) {
+		if (std::find(this->ready.begin(), this->ready.begin() + 6, false) != this->ready.begin() + 6)
+			throw std::runtime_error("ERR System Cannot Initialize - System Not Ready");
+		this->ready.at(6) = true;
+		this->event_log.setLevel(log_level_t::log_off, false);
+		this->startRun();
+		for (const Task &this_task: _tasks) {
+			clock_count = std::max(clock_count, this_task.getArriveTime());//jump to the next event
+			if (!this->runTask(this_task))
+				break;
+		}
+		this->finishRun();
+	}
+
+	/**
+	 * Silence the Echo of Every Instruction
+	 */
+	void setQuiet(const bool &_quiet) {
+		this->quiet = _quiet;
+	}
+
+	[[nodiscard]] uint64_t getClockCount() const {
+		return this->clock_count;
+	}
+
+	[[nodiscard]] size_t getCacheCount() const {
+		return this->cache_count;
+	}
+
+	/**
+	 * Get the Hit and Miss Count of a Cache Level, Summed over Every Core's Copy of a Private Level
+	 * @param _cache_level The level(index) of cache with lowest being 1
+	 * @return [Hits][Misses]
+	 */
+	[[nodiscard]] std::pair<uint64_t, uint64_t> getCacheHitMiss(const uint32_t &_cache_level) {
+		std::pair<uint64_t, uint64_t> hit_miss_count{0, 0};
+		for (Cache *this_cache: this->getCacheCopies(_cache_level)) {//summed over the cores of a private level
+			hit_miss_count.first += this_cache->getHitMissCount().first;
+			hit_miss_count.second += this_cache->getHitMissCount().second;
+		}
+		return hit_miss_count;
+	}
+
+	/**
+	 * Run the Sorted Task Queue as a Discrete-Event Timeline
+	 * Instead of ticking the clock one cycle at a time until the next task arrives, the clock jumps
+	 * straight to max(clock_count, arrive_time), so runtime depends on the number of tasks only.
+	 */
 	void runTaskQueue() {
-		auto current_task_ptr = this->task_queue.begin();
-		while (current_task_ptr != this->task_queue.end()) {
-			if (current_task_ptr->getArriveTime() <= clock_count) {
-				task_t this_task = current_task_ptr->getTaskType();
-				uint32_t this_value = current_task_ptr->getTaskValue();
-				uint32_t this_arrive_time = current_task_ptr->getArriveTime();
-				if (this_task == task_t::task_halt) {
-					report_writer.first.close();
-					return;
-				} else if (this_task == task_t::task_reportHitMiss)
-					this->getCacheAtPtr(this_value)->printHitMissRate(this_arrive_time);
-				else if (this_task == task_t::task_reportImage)
-					this->getCacheAtPtr(this_value)->printCacheImage(this_arrive_time);
-				else if (this_task == task_t::task_readAddress) {
-					clock_count = this->readCache(this->top_cache_ptr.get(), this_value, clock_count);
-					report_writer.first << std::endl;
-				} else if (this_task == task_t::task_writeAddress) {
-					clock_count = this->writeCache(this->top_cache_ptr.get(), this_value, clock_count);
-					report_writer.first << std::endl;
-				}
-				current_task_ptr++;
-			} else clock_count++;
+		for (const Task &this_task: this->task_queue) {
+			clock_count = std::max(clock_count, this_task.getArriveTime());//jump to the next event
+			if (!this->runTask(this_task))
+				break;
 		}
-		report_writer.first.close();
 	}
 
 };
@@ -0,0 +1,222 @@
+#ifndef CODE_TAGSTORE_H
+#define CODE_TAGSTORE_H
+
+#include "Include.h"
+#include "Checkpoint.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/* Flat Structure-of-Arrays Storage of the Tags of a Cache
+ *
+ * All sets live in one contiguous allocation:
+ * tags[set * assoc + way] holds the tag of Cache[set][way]
+ * valid/dirty are bitmasks, mask_words 64-bit words per set, bit (way % 64) of word (way / 64)
+ *
+ * A 16-way set of 32-bit tags is exactly one 64-byte cache line, and its valid/dirty words are a second one,
+ * so a lookup in one set touches one or two cache lines instead of chasing a pointer per set. Tags are as wide as
+ * addresses (address_t), so 64-bit builds take two lines per 16 ways.
+ * Replacement state is NOT kept here; it is owned by the Cache, indexed the same way.
+ */
+class TagStore {
+private:
+	//Number of Sets (Number of Indices)
+	uint32_t set_count{0};
+
+	//Number of Ways per Set (Set Associativity)
+	uint32_t assoc{0};
+
+	//Number of 64-bit Words of Valid/Dirty Bits per Set
+	uint32_t mask_words{0};
+
+	//Tag of Each Way, Set-Major
+	std::vector<address_t> tags;
+
+	//Valid Bits of Each Way, mask_words Words per Set
+	std::vector<uint64_t> valid_masks;
+
+	//Dirty Bits of Each Way, mask_words Words per Set
+	std::vector<uint64_t> dirty_masks;
+
+	[[nodiscard]] size_t wordOf(const uint32_t &_set, const uint32_t &_way) const {
+		return size_t{_set} * this->mask_words + (_way >> 6);
+	}
+
+	[[nodiscard]] static uint64_t bitOf(const uint32_t &_way) {
+		return uint64_t{1} << (_way & 63);
+	}
+
+	/**
+	 * Compare a Tag against up to 64 Consecutive Ways in One Pass
+	 * Uses AVX2 (8 ways per compare) or SSE2 (4 ways per compare) when the build enables them, halved for 64-bit
+	 * tags (which SSE needs SSE4.1 for), and finishes the remainder with scalar compares.
+	 * @param _set_tags First tag of the ways to compare
+	 * @param _count Number of ways to compare (at most 64)
+	 * @param _tag Tag to be Looked Up
+	 * @return Bit i set if way i holds the tag (validity is NOT checked)
+	 */
+	[[nodiscard]] static uint64_t matchWord(const address_t *_set_tags, const uint32_t &_count, const address_t &_tag) {
+		uint64_t match_bits{0};
+		uint32_t way{0};
+		if constexpr (sizeof(address_t) == 4) {
+#if defined(__AVX2__)
+			const __m256i probe_8 = _mm256_set1_epi32(static_cast<int32_t>(_tag));
+			for (; way + 8 <= _count; way += 8) {
+				__m256i tags_8 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_set_tags + way));
+				uint32_t bits = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(tags_8, probe_8)));
+				match_bits |= uint64_t{bits} << way;
+			}
+#endif
+#if defined(__SSE2__)
+			const __m128i probe_4 = _mm_set1_epi32(static_cast<int32_t>(_tag));
+			for (; way + 4 <= _count; way += 4) {
+				__m128i tags_4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_set_tags + way));
+				uint32_t bits = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(tags_4, probe_4)));
+				match_bits |= uint64_t{bits} << way;
+			}
+#endif
+		} else {
+#if defined(__AVX2__)
+			const __m256i probe_4 = _mm256_set1_epi64x(static_cast<int64_t>(_tag));
+			for (; way + 4 <= _count; way += 4) {
+				__m256i tags_4 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_set_tags + way));
+				uint32_t bits = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(tags_4, probe_4)));
+				match_bits |= uint64_t{bits} << way;
+			}
+#endif
+#if defined(__SSE4_1__)
+			const __m128i probe_2 = _mm_set1_epi64x(static_cast<int64_t>(_tag));
+			for (; way + 2 <= _count; way += 2) {
+				__m128i tags_2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_set_tags + way));
+				uint32_t bits = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(tags_2, probe_2)));
+				match_bits |= uint64_t{bits} << way;
+			}
+#endif
+		}
+		for (; way < _count; way++)
+			match_bits |= uint64_t{_set_tags[way] == _tag} << way;
+		return match_bits;
+	}
+
+public:
+
+	/**
+	 * Allocate the Store with All Ways Invalid, Non-Dirty and Zero-Tagged
+	 * @param _set_count Number of Sets
+	 * @param _assoc Number of Ways per Set
+	 */
+	void init(const uint32_t &_set_count, const uint32_t &_assoc) {
+		this->set_count = _set_count;
+		this->assoc = _assoc;
+		this->mask_words = (_assoc + 63) / 64;
+		this->tags.assign(size_t{_set_count} * _assoc, 0);
+		this->valid_masks.assign(size_t{_set_count} * this->mask_words, 0);
+		this->dirty_masks.assign(size_t{_set_count} * this->mask_words, 0);
+	}
+
+	/**
+	 * Find the Way of a Set Holding a Valid Copy of a Tag, Comparing every Way at once
+	 * @param _set Index of the Set
+	 * @param _tag Tag to be Looked Up
+	 * @return Way holding the tag, or -1 if none
+	 */
+	[[nodiscard]] int64_t findTag(const uint32_t &_set, const address_t &_tag) const {
+		const address_t *set_tags = &this->tags[size_t{_set} * this->assoc];
+		const uint64_t *set_valid = &this->valid_masks[size_t{_set} * this->mask_words];
+		for (uint32_t word = 0; word < this->mask_words; word++) {
+			uint32_t base_way = word * 64;
+			uint32_t count = std::min<uint32_t>(64, this->assoc - base_way);
+			uint64_t hit_bits = matchWord(set_tags + base_way, count, _tag) & set_valid[word];
+			if (hit_bits != 0)
+				return base_way + __builtin_ctzll(hit_bits);
+		}
+		return -1;
+	}
+
+	/**
+	 * Find the First Invalid Way of a Set
+	 * @param _set Index of the Set
+	 * @return First invalid way, or -1 if the set is full
+	 */
+	[[nodiscard]] int64_t findInvalid(const uint32_t &_set) const {
+		const uint64_t *set_valid = &this->valid_masks[size_t{_set} * this->mask_words];
+		for (uint32_t word = 0; word < this->mask_words; word++) {
+			uint64_t free_bits = ~set_valid[word];
+			if (free_bits == 0) continue;
+			uint32_t way = word * 64 + __builtin_ctzll(free_bits);
+			return way < this->assoc ? int64_t{way} : -1;
+		}
+		return -1;
+	}
+
+	/**
+	 * Make a Way Valid with a New Tag
+	 * @param _set Index of the Set
+	 * @param _way Way to be Filled
+	 * @param _tag New Tag
+	 * @param _dirty If the Way should be Dirty
+	 */
+	void fill(const uint32_t &_set, const uint32_t &_way, const address_t &_tag, const bool &_dirty) {
+		this->tags[size_t{_set} * this->assoc + _way] = _tag;
+		this->valid_masks[wordOf(_set, _way)] |= bitOf(_way);
+		this->setDirty(_set, _way, _dirty);
+	}
+
+	/**
+	 * Flush a Way to make it Available to Fill
+	 */
+	void invalidate(const uint32_t &_set, const uint32_t &_way) {
+		this->tags[size_t{_set} * this->assoc + _way] = 0;
+		this->valid_masks[wordOf(_set, _way)] &= ~bitOf(_way);
+		this->dirty_masks[wordOf(_set, _way)] &= ~bitOf(_way);
+	}
+
+	void setDirty(const uint32_t &_set, const uint32_t &_way, const bool &_dirty) {
+		if (_dirty)
+			this->dirty_masks[wordOf(_set, _way)] |= bitOf(_way);
+		else
+			this->dirty_masks[wordOf(_set, _way)] &= ~bitOf(_way);
+	}
+
+	[[nodiscard]] bool getValid(const uint32_t &_set, const uint32_t &_way) const {
+		return (this->valid_masks[wordOf(_set, _way)] & bitOf(_way)) != 0;
+	}
+
+	[[nodiscard]] bool getDirty(const uint32_t &_set, const uint32_t &_way) const {
+		return (this->dirty_masks[wordOf(_set, _way)] & bitOf(_way)) != 0;
+	}
+
+	[[nodiscard]] address_t getTag(const uint32_t &_set, const uint32_t &_way) const {
+		return this->tags[size_t{_set} * this->assoc + _way];
+	}
+
+	[[nodiscard]] uint32_t getSetCount() const {
+		return this->set_count;
+	}
+
+	[[nodiscard]] uint32_t getAssoc() const {
+		return this->assoc;
+	}
+
+	/**
+	 * Write Tags, Valid and Dirty Bits to a Checkpoint
+	 */
+	void saveState(CheckpointWriter &_writer) const {
+		_writer.writeVector(this->tags);
+		_writer.writeVector(this->valid_masks);
+		_writer.writeVector(this->dirty_masks);
+	}
+
+	/**
+	 * Restore Tags, Valid and Dirty Bits from a Checkpoint of a Store of the Same Dimensions
+	 */
+	void loadState(CheckpointReader &_reader) {
+		_reader.readArray(this->tags.data(), this->tags.size());
+		_reader.readArray(this->valid_masks.data(), this->valid_masks.size());
+		_reader.readArray(this->dirty_masks.data(), this->dirty_masks.size());
+	}
+
+};
+
+#endif //CODE_TAGSTORE_H
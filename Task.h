@@ -7,15 +7,18 @@
 class Task {
 private:
 	task_t task_type;
-	uint32_t task_value;
+	address_t task_value;
 	uint64_t arrive_time;
+	uint16_t core_id;
 	bool ready;
 public:
 
-	Task(const task_t &_task_type, const uint32_t &_task_value, const uint64_t &_arrive_time) {
+	Task(const task_t &_task_type, const address_t &_task_value, const uint64_t &_arrive_time,
+		 const uint16_t &_core_id = 0) {
 		this->task_type = _task_type;
 		this->task_value = _task_value;
 		this->arrive_time = _arrive_time;
+		this->core_id = _core_id;
 		this->ready = true;
 	}
 
@@ -29,10 +32,14 @@ public:
 			return this->arrive_time < _task.arrive_time;
 		}
 		else if ((my_t == task_t::task_readAddress || my_t == task_t::task_writeAddress) &&
-			(his_t == task_t::task_reportImage || his_t == task_t::task_reportHitMiss)) {
+			(his_t == task_t::task_reportImage || his_t == task_t::task_reportHitMiss ||
+			 his_t == task_t::task_reportCoherence || his_t == task_t::task_saveCheckpoint ||
+			 his_t == task_t::task_reportCounts || his_t == task_t::task_reportLatency)) {
 			return false;
 		} else if ((his_t == task_t::task_readAddress || his_t == task_t::task_writeAddress) &&
-				   (my_t == task_t::task_reportImage || my_t == task_t::task_reportHitMiss)) {
+				   (my_t == task_t::task_reportImage || my_t == task_t::task_reportHitMiss ||
+					my_t == task_t::task_reportCoherence || my_t == task_t::task_saveCheckpoint ||
+					my_t == task_t::task_reportCounts || my_t == task_t::task_reportLatency)) {
 			return true;
 		}else
 			return false;
@@ -42,7 +49,7 @@ public:
 		return this->task_type;
 	}
 
-	[[nodiscard]] uint32_t getTaskValue() const {
+	[[nodiscard]] address_t getTaskValue() const {
 		return this->task_value;
 	}
 
@@ -50,6 +57,10 @@ public:
 		return this->arrive_time;
 	}
 
+	[[nodiscard]] uint16_t getCoreId() const {
+		return this->core_id;
+	}
+
 };
 
 
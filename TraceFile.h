@@ -0,0 +1,328 @@
+#ifndef CODE_TRACEFILE_H
+#define CODE_TRACEFILE_H
+
+#include "Include.h"
+#include "Task.h"
+#include "MappedFile.h"
+
+#include <cstring>
+
+/* Binary Trace Format (.ctr), Little-Endian
+ *
+ * [Header, 32 Bytes]
+ *   magic        char[8]   "CSTRACE\0"
+ *   version      uint32    1 for 32-bit builds, 2 for 64-bit builds (CACHESIM_ADDRESS_64)
+ *   record_size  uint32    16, or 24 in 64-bit builds
+ *   record_count uint64    Number of records that follow
+ *   reserved     uint64    0
+ *
+ * [Records, record_size Bytes Each]
+ *   value        uint64    Address for reads/writes, cache level (or core ID for pcc) for reports; version 1 keeps
+ *                          it in the low 48 bits and the core ID in the high 16 bits
+ *   time_op      uint64    Arrive time in the low 56 bits, task_t of the record in the high 8 bits
+ *   core_id      uint16    Core ID (version 2 only, where value holds the full 64-bit address)
+ *   reserved     uint16[3] 0 (version 2 only)
+ *
+ * Records carry the same tasks as tre/twr/tcr/tcw/pcr/pci/pcc/sck/pcs/plh, in any order; System sorts them like text
+ * tasks. A record of any other task_t is rejected when it is read. A trace can only be read by a simulator of the
+ * address width that wrote it.
+ */
+struct TraceHeader {
+	static constexpr uint32_t TRACE_VERSION = ADDRESS_BITS == 64 ? 2 : 1;
+
+	char magic[8]{'C', 'S', 'T', 'R', 'A', 'C', 'E', '\0'};
+	uint32_t version{TRACE_VERSION};
+	uint32_t record_size{ADDRESS_BITS == 64 ? 24 : 16};
+	uint64_t record_count{0};
+	uint64_t reserved{0};
+};
+
+struct TraceRecord {
+	uint64_t value{0};
+	uint64_t time_op{0};
+#ifdef CACHESIM_ADDRESS_64
+	uint16_t core_id{0};
+	uint16_t reserved[3]{};//named so the padding is written as zeros, keeping traces of the same script identical
+#endif
+
+	static constexpr uint64_t TIME_MASK = (uint64_t{1} << 56) - 1;
+	static constexpr uint64_t ADDRESS_MASK = (uint64_t{1} << 48) - 1;//of version 1 values
+
+	TraceRecord() = default;
+
+	TraceRecord(const task_t &_task_type, const uint64_t &_value, const uint64_t &_arrive_time,
+				const uint16_t &_core_id = 0) {
+		if (_arrive_time > TIME_MASK)
+			throw std::out_of_range("ERR Arrive Time does not Fit in Trace Record");
+#ifdef CACHESIM_ADDRESS_64
+		this->value = _value;
+		this->core_id = _core_id;
+#else
+		if (_value > ADDRESS_MASK)
+			throw std::out_of_range("ERR Trace Value does not Fit in Trace Record");
+		this->value = (uint64_t{_core_id} << 48) | _value;
+#endif
+		this->time_op = (uint64_t(_task_type) << 56) | _arrive_time;
+	}
+
+	/**
+	 * Get the Task Type, Rejecting Operations no Trace Instruction Writes
+	 */
+	[[nodiscard]] task_t getTaskType() const {
+		const auto task_type = static_cast<task_t>(time_op >> 56);
+		if (task_type > task_t::task_reportLatency || task_type == task_t::task_halt)
+			throw std::runtime_error("ERR Unknown Operation in Trace Record");
+		return task_type;
+	}
+
+	[[nodiscard]] uint64_t getArriveTime() const {
+		return time_op & TIME_MASK;
+	}
+
+	[[nodiscard]] uint64_t getValue() const {
+#ifdef CACHESIM_ADDRESS_64
+		return value;
+#else
+		return value & ADDRESS_MASK;
+#endif
+	}
+
+	[[nodiscard]] uint16_t getCoreId() const {
+#ifdef CACHESIM_ADDRESS_64
+		return core_id;
+#else
+		return static_cast<uint16_t>(value >> 48);
+#endif
+	}
+
+	/**
+	 * Convert to a Task, Checking the Value Fits the Task's Address Width
+	 */
+	[[nodiscard]] Task toTask() const {
+		if (getValue() > ADDRESS_MAX)
+			throw std::out_of_range("ERR Trace Value does not Fit in an Address");
+		return Task{getTaskType(), static_cast<address_t>(getValue()), getArriveTime(), getCoreId()};
+	}
+};
+
+static_assert(sizeof(TraceHeader) == 32, "Trace Header Must be 32 Bytes");
+static_assert(sizeof(TraceRecord) == TraceHeader{}.record_size, "Trace Record Must be 16 Bytes (24 in 64-bit Builds)");
+
+/* Memory-Mapped Reader of a Binary Trace
+ *
+ * Records are read in place from the mapping; nothing is copied or parsed per record.
+ */
+class TraceReader {
+private:
+	MappedFile mapped_file;
+	const TraceRecord *records{nullptr};
+	uint64_t record_count{0};
+
+public:
+
+	explicit TraceReader(const std::string &_filename) : mapped_file(_filename) {
+		if (mapped_file.getLength() < sizeof(TraceHeader))
+			throw std::runtime_error("ERR Trace File Too Short");
+		TraceHeader header;
+		std::memcpy(&header, mapped_file.getData(), sizeof(TraceHeader));
+		if (std::memcmp(header.magic, TraceHeader{}.magic, sizeof(header.magic)) != 0)
+			throw std::runtime_error("ERR Not a Binary Trace File");
+		if (header.version != TraceHeader::TRACE_VERSION || header.record_size != sizeof(TraceRecord))
+			throw std::runtime_error("ERR Not a Binary Trace of this Address Width");
+		if (header.record_count > (mapped_file.getLength() - sizeof(TraceHeader)) / sizeof(TraceRecord))
+			throw std::runtime_error("ERR Binary Trace Truncated");
+		this->records = reinterpret_cast<const TraceRecord *>(mapped_file.getData() + sizeof(TraceHeader));
+		this->record_count = header.record_count;
+	}
+
+	[[nodiscard]] const TraceRecord *begin() const {
+		return this->records;
+	}
+
+	[[nodiscard]] const TraceRecord *end() const {
+		return this->records + this->record_count;
+	}
+
+	[[nodiscard]] uint64_t size() const {
+		return this->record_count;
+	}
+};
+
+/* Buffered Writer of a Binary Trace
+ *
+ * The record count in the header is patched when the writer is closed.
+ */
+class TraceWriter {
+private:
+	std::ofstream trace_writer;
+	std::vector<TraceRecord> buffer;
+	uint64_t record_count{0};
+
+	static constexpr size_t BUFFER_RECORDS = 1 << 16;
+
+	void flushBuffer() {
+		trace_writer.write(reinterpret_cast<const char *>(buffer.data()),
+						   static_cast<std::streamsize>(buffer.size() * sizeof(TraceRecord)));
+		buffer.clear();
+	}
+
+public:
+
+	explicit TraceWriter(const std::string &_filename) : trace_writer(_filename, std::ios::binary | std::ios::trunc) {
+		if (!trace_writer.is_open())
+			throw std::runtime_error("ERR Cannot Open Trace File " + _filename);
+		TraceHeader header;
+		trace_writer.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		buffer.reserve(BUFFER_RECORDS);
+	}
+
+	TraceWriter(const TraceWriter &) = delete;
+
+	TraceWriter &operator=(const TraceWriter &) = delete;
+
+	~TraceWriter() {
+		this->close();
+	}
+
+	void append(const TraceRecord &_record) {
+		buffer.push_back(_record);
+		record_count++;
+		if (buffer.size() == BUFFER_RECORDS)
+			flushBuffer();
+	}
+
+	/**
+	 * Flush Remaining Records and Write the Final Record Count into the Header
+	 */
+	void close() {
+		if (!trace_writer.is_open()) return;
+		flushBuffer();
+		TraceHeader header;
+		header.record_count = record_count;
+		trace_writer.seekp(0);
+		trace_writer.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		trace_writer.close();
+	}
+
+	[[nodiscard]] uint64_t size() const {
+		return this->record_count;
+	}
+};
+
+/**
+ * Parse the Tasks of a Text Instruction File
+ * tre/twr/tcr/tcw/pcr/pci/pcc/sck become records; configuration instructions and unknown words (comments) are
+ * skipped, and parsing stops at hat, the same way Core reads the file. Generator instructions (gsq/gru/gzf/gpc/gpt) depend
+ * on the configured block size and cores, so they are rejected rather than silently dropped.
+ * Arguments are parsed in place from the mapped text.
+ * @param _text_filename Instruction file with $-arguments
+ * @param _on_record Called with every record, in file order
+ */
+template<typename RecordHandler>
+void parseTextTrace(const std::string &_text_filename, RecordHandler &&_on_record) {
+	const std::unordered_map<std::string, std::pair<int, size_t>> instruction_kinds{
+			{"con", {-1, 3}}, {"scd", {-1, 3}}, {"scl", {-1, 2}}, {"srp", {-1, 2}}, {"sml", {-1, 1}},
+			{"inc", {-1, 1}}, {"stm", {-1, 1}}, {"lgv", {-1, 2}}, {"sss", {-1, 2}}, {"spf", {-1, 3}}, {"cor", {-1, 3}},
+			{"mhr", {-1, 2}}, {"sip", {-1, 1}}, {"svc", {-1, 2}}, {"par", {-1, 1}}, {"lck", {-1, 1}}, {"ffw", {-1, 2}},
+			{"sis", {-1, 3}}, {"sim", {-1, 1}}, {"sce", {-1, 1}}, {"gcf", {-1, 3}},
+			{"ins", {-1, 0}},
+			{"gsq", {-2, 3}}, {"gru", {-2, 3}}, {"gzf", {-2, 3}}, {"gpc", {-2, 3}}, {"gpt", {-2, 3}},
+			{"tre", {int(task_t::task_readAddress), 2}}, {"twr", {int(task_t::task_writeAddress), 2}},
+			{"tcr", {int(task_t::task_readAddress), 3}}, {"tcw", {int(task_t::task_writeAddress), 3}},
+			{"pcr", {int(task_t::task_reportHitMiss), 2}}, {"pci", {int(task_t::task_reportImage), 2}},
+			{"pcc", {int(task_t::task_reportCoherence), 2}}, {"sck", {int(task_t::task_saveCheckpoint), 2}},
+			{"pcs", {int(task_t::task_reportCounts), 2}}, {"plh", {int(task_t::task_reportLatency), 2}}};
+	MappedFile text_file(_text_filename);
+	const char *cursor = text_file.getData();
+	const char *text_end = cursor + text_file.getLength();
+	auto nextWord = [&cursor, &text_end]() -> std::pair<const char *, size_t> {
+		while (cursor < text_end && std::isspace(static_cast<unsigned char>(*cursor))) cursor++;
+		const char *word_begin = cursor;
+		while (cursor < text_end && !std::isspace(static_cast<unsigned char>(*cursor))) cursor++;
+		return {word_begin, size_t(cursor - word_begin)};
+	};
+	auto wordToInt = [](const std::pair<const char *, size_t> &_word) -> uint64_t {
+		if (_word.second < 2 || _word.first[0] != '$')
+			throw std::runtime_error("ERR Instruction Argument Format Error");
+		uint64_t value{0};
+		for (size_t i = 1; i < _word.second; i++) {
+			if (!std::isdigit(static_cast<unsigned char>(_word.first[i])))
+				throw std::runtime_error("ERR Instruction Argument Format Error");
+			uint64_t digit = _word.first[i] - '0';
+			if (value > (ADDRESS_MAX - digit) / 10)//same bound as Core's arguments
+				throw std::out_of_range("ERR Instruction Argument Wider than an Address");
+			value = value * 10 + digit;
+		}
+		return value;
+	};
+	while (cursor < text_end) {
+		auto word = nextWord();
+		if (word.second != 3) continue;
+		if (std::string(word.first, word.second) == "hat") break;//Core ignores everything after hat
+		auto kind = instruction_kinds.find(std::string(word.first, word.second));
+		if (kind == instruction_kinds.end()) continue;
+		if (kind->second.first == -2)
+			throw std::runtime_error("ERR Generator Instructions Cannot be Read as a Trace");
+		if (kind->second.first < 0) {//configuration instruction, skip its arguments
+			for (size_t i = 0; i < kind->second.second; i++) nextWord();
+			continue;
+		}
+		uint64_t value = wordToInt(nextWord());
+		uint64_t arrive_time = wordToInt(nextWord());
+		uint64_t core_id = kind->second.second == 3 ? wordToInt(nextWord()) : 0;//tcr/tcw name their core
+		if (core_id > UINT16_MAX)
+			throw std::out_of_range("ERR Core ID does not Fit in Trace Record");
+		_on_record(TraceRecord{static_cast<task_t>(kind->second.first), value, arrive_time,
+							   static_cast<uint16_t>(core_id)});
+	}
+}
+
+/**
+ * Convert the Tasks of a Text Instruction File to a Binary Trace
+ * @param _text_filename Instruction file with $-arguments
+ * @param _trace_filename Binary trace file to be written
+ * @return Number of records written
+ */
+inline uint64_t convertTextTrace(const std::string &_text_filename, const std::string &_trace_filename) {
+	TraceWriter trace_writer(_trace_filename);
+	parseTextTrace(_text_filename, [&trace_writer](const TraceRecord &_record) { trace_writer.append(_record); });
+	trace_writer.close();
+	return trace_writer.size();
+}
+
+/**
+ * Check if a File Starts with the Binary Trace Magic
+ */
+inline bool isBinaryTrace(const std::string &_filename) {
+	std::ifstream trace_reader{_filename, std::ios::binary};
+	char magic[8]{};
+	trace_reader.read(magic, sizeof(magic));
+	return trace_reader && std::memcmp(magic, TraceHeader{}.magic, sizeof(magic)) == 0;
+}
+
+/**
+ * Read the Accesses (tre/twr) of a Text or Binary Trace into Arrive-Time Order
+ * Report tasks are dropped; the list is only sorted if the trace was out of order
+ * @param _trace_filename Text instruction file or binary trace
+ * @return Read and write tasks, sorted
+ */
+inline std::vector<Task> loadSortedAccesses(const std::string &_trace_filename) {
+	std::vector<Task> tasks;
+	auto keepAccess = [&tasks](const TraceRecord &_record) {
+		task_t this_task = _record.getTaskType();
+		if (this_task == task_t::task_readAddress || this_task == task_t::task_writeAddress)
+			tasks.push_back(_record.toTask());
+	};
+	if (isBinaryTrace(_trace_filename)) {
+		TraceReader trace_reader(_trace_filename);
+		tasks.reserve(trace_reader.size());
+		for (const TraceRecord &this_record: trace_reader)
+			keepAccess(this_record);
+	} else
+		parseTextTrace(_trace_filename, keepAccess);
+	if (!std::is_sorted(tasks.begin(), tasks.end()))
+		std::stable_sort(tasks.begin(), tasks.end());
+	return tasks;
+}
+
+#endif //CODE_TRACEFILE_H
@@ -0,0 +1,156 @@
+#ifndef CODE_VICTIMCACHE_H
+#define CODE_VICTIMCACHE_H
+
+#include "Include.h"
+#include "Checkpoint.h"
+
+/* Small Fully-Associative LRU Buffer of the Blocks Evicted from One Cache Level
+ *
+ * A miss of the level that finds its block here takes it back instead of going further down; a block the buffer
+ * pushes out to make room carries on to the level below. Entries are few, so they are scanned linearly.
+ *
+ * Counters: hits (blocks taken back); insertions (victims of the level taken in); write-backs (dirty blocks pushed out).
+ */
+class VictimCache {
+public:
+	struct VictimCount {
+		uint64_t hits{0};
+		uint64_t insertions{0};
+		uint64_t writebacks{0};
+	};
+
+private:
+	struct VictimEntry {
+		address_t block{0};
+		address_t address{0};
+		bool dirty{false};
+		uint64_t last_use{0};
+	};
+
+	size_t capacity{0};
+	uint32_t offset_bits{0};
+	uint64_t use_clock{0};
+	std::vector<VictimEntry> entries;
+	VictimCount counts;
+
+	[[nodiscard]] std::vector<VictimEntry>::iterator find(const address_t &_address) {
+		const address_t block = _address >> this->offset_bits;
+		return std::find_if(this->entries.begin(), this->entries.end(),
+							[&block](const VictimEntry &_entry) { return _entry.block == block; });
+	}
+
+public:
+
+	/**
+	 * Set the Number of Entries
+	 * @param _entries Blocks the buffer holds
+	 * @param _offset_bits Offset bits of the cache, to match addresses by block
+	 */
+	void configure(const uint32_t &_entries, const uint32_t &_offset_bits) {
+		if (_entries == 0)
+			throw std::invalid_argument("ERR Victim Cache Entries Must be Positive");
+		this->capacity = _entries;
+		this->offset_bits = _offset_bits;
+		this->entries.clear();
+		this->entries.reserve(_entries);
+	}
+
+	[[nodiscard]] bool isEnabled() const {
+		return this->capacity != 0;
+	}
+
+	[[nodiscard]] const VictimCount &getCounts() const {
+		return this->counts;
+	}
+
+	void resetCounts() {
+		this->counts = {};
+	}
+
+	/**
+	 * Take a Block Back out of the Buffer
+	 * @param _address Raw address of the block
+	 * @param _dirty Set to the dirty bit of the block, if found
+	 * @return True if the buffer held the block
+	 */
+	bool take(const address_t &_address, bool &_dirty) {
+		auto found = this->find(_address);
+		if (found == this->entries.end())
+			return false;
+		_dirty = found->dirty;
+		this->entries.erase(found);
+		this->counts.hits++;
+		return true;
+	}
+
+	/**
+	 * Look Up a Block for Coherence or Back-Invalidation, without Counting a Hit
+	 * A found block is made clean (its data is written back by the caller if it was dirty)
+	 * @param _address Raw address of the block
+	 * @param _invalidate If the found block should also be dropped
+	 * @return [If the Block was Present][If it was Dirty]
+	 */
+	std::pair<bool, bool> snoop(const address_t &_address, const bool &_invalidate) {
+		auto found = this->find(_address);
+		if (found == this->entries.end())
+			return {false, false};
+		bool was_dirty = found->dirty;
+		if (_invalidate)
+			this->entries.erase(found);
+		else
+			found->dirty = false;
+		return {true, was_dirty};
+	}
+
+	/**
+	 * Take in a Victim of the Level, Pushing Out the Least Recently Inserted Block if Full
+	 * @param _victim [If Dirty][Raw Address] of the victim, replaced by the block pushed out, if any
+	 * @return True if a block was pushed out
+	 */
+	bool insert(std::pair<bool, address_t> &_victim) {
+		this->counts.insertions++;
+		auto found = this->find(_victim.second);
+		if (found != this->entries.end()) {//already held: only the dirty bit is merged
+			found->dirty |= _victim.first;
+			found->last_use = ++this->use_clock;
+			return false;
+		}
+		VictimEntry entry{_victim.second >> this->offset_bits, _victim.second, _victim.first, ++this->use_clock};
+		if (this->entries.size() < this->capacity) {
+			this->entries.push_back(entry);
+			return false;
+		}
+		auto oldest = std::min_element(this->entries.begin(), this->entries.end(),
+									   [](const VictimEntry &_a, const VictimEntry &_b) {
+										   return _a.last_use < _b.last_use;
+									   });
+		_victim = {oldest->dirty, oldest->address};
+		this->counts.writebacks += oldest->dirty;
+		*oldest = entry;
+		return true;
+	}
+
+	/**
+	 * Write the Entries and Counters to a Checkpoint
+	 */
+	void saveState(CheckpointWriter &_writer) const {
+		_writer.write(uint64_t{this->capacity});
+		_writer.write(this->use_clock);
+		_writer.write(this->counts);
+		_writer.writeVector(this->entries);
+	}
+
+	/**
+	 * Restore the Entries and Counters into a Victim Cache of the Same Capacity
+	 */
+	void loadState(CheckpointReader &_reader) {
+		_reader.expect(uint64_t{this->capacity});
+		this->use_clock = _reader.read<uint64_t>();
+		this->counts = _reader.read<VictimCount>();
+		_reader.readVector(this->entries);
+		if (this->entries.size() > this->capacity)
+			throw std::runtime_error("ERR Checkpoint does not Match the Hierarchy");
+	}
+};
+
+#endif //CODE_VICTIMCACHE_H
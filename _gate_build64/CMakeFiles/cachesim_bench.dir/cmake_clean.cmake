@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cachesim_bench.dir/bench.cpp.o"
+  "CMakeFiles/cachesim_bench.dir/bench.cpp.o.d"
+  "cachesim_bench"
+  "cachesim_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cachesim_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
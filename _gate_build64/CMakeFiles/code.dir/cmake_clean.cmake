@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/code.dir/main.cpp.o"
+  "CMakeFiles/code.dir/main.cpp.o.d"
+  "code"
+  "code.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/code.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+#include "Bench.h"
+
+int main(int argc, char *argv[]) {
+	if (argc < 2 || argc > 5)
+		throw std::invalid_argument("USAGE: cachesim_bench results.csv [accesses] [repeats] [label]");
+	Bench running_bench(argc >= 3 ? std::stoull(argv[2]) : 1000000, argc >= 4 ? std::stoul(argv[3]) : 3);
+	running_bench.run("cachesim_bench_");
+	running_bench.printResults(argv[1], argc == 5 ? argv[4] : "");
+	return 0;
+}
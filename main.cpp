@@ -1,7 +1,38 @@
 #include "Core.h"
+#include "Sweep.h"
+#include "StackDistance.h"
 
 int main(int argc, char *argv[]) {
-	if (argc == 2) {
+	if (argc == 4 && std::string{argv[1]} == "--convert") {
+		uint64_t record_count = convertTextTrace(argv[2], argv[3]);
+		std::cout << "converted " << record_count << " tasks" << std::endl;
+	} else if (argc == 4 && std::string{argv[1]} == "--print-log") {
+		uint64_t event_count = EventLog::printBinaryLog(argv[2], argv[3]);
+		std::cout << "printed " << event_count << " events" << std::endl;
+	} else if (argc == 4 && std::string{argv[1]} == "--print-stats") {
+		uint64_t record_count = IntervalStats::printBinaryStats(argv[2], argv[3]);
+		std::cout << "printed " << record_count << " intervals" << std::endl;
+	} else if (argc == 5 && std::string{argv[1]} == "--rebuild-image") {
+		uint64_t delta_count = Cache::rebuildImage(argv[2], std::stoull(argv[3]), argv[4]);
+		std::cout << "rebuilt from " << delta_count << " delta images" << std::endl;
+	} else if ((argc == 5 || argc == 6) && std::string{argv[1]} == "--sweep") {
+		Sweep running_sweep(argv[2], argv[3]);
+		size_t config_count = running_sweep.run(argv[4], argc == 6 ? std::stoul(argv[5]) : 0);
+		std::cout << "swept " << config_count << " configurations over " << running_sweep.getTaskCount()
+				  << " tasks" << std::endl;
+	} else if ((argc == 7 || argc == 8) && std::string{argv[1]} == "--mrc") {
+		std::vector<Task> tasks = loadSortedAccesses(argv[2]);
+		StackDistance stack_distance(std::stoul(argv[3]), std::stoul(argv[4]), std::stoul(argv[5]));
+		stack_distance.run(tasks);
+		bool check = argc == 8 && std::string{argv[7]} == "check";
+		uint64_t mismatch_count = stack_distance.printCurves(argv[6], check ? &tasks : nullptr);
+		std::cout << "profiled " << tasks.size() << " tasks";
+		if (check)
+			std::cout << ", " << mismatch_count << " points differ from simulation";
+		std::cout << std::endl;
+	} else if (argc == 3) {
+		Core running_core(std::string{argv[1]}, std::string{argv[2]});
+	} else if (argc == 2) {
 		std::string argument{argv[1]};
 		Core running_core(argument);
 	} else